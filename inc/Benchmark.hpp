@@ -0,0 +1,167 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <cstdint>
+
+// Result of a single benchmark case
+struct BenchmarkResult
+{
+    std::string name;       // benchmarked function
+    std::string params;     // benchmark case parameters, e.g. "rows=1024;cols=64"
+    double nsPerIter;       // median time of one iteration in nanoseconds
+    double itemsPerSec;     // processed items (data rows, elements, ...) per second
+};
+
+// Prevent the compiler from optimizing away benchmarked results
+template<class T>
+inline void doNotOptimize(T const& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Run benchmark case and return median time of one iteration
+// fn is repeated until minTimeSec passes, measurement is repeated samplesNo times
+// itemsPerIter -> number of items processed by one call of fn
+inline BenchmarkResult runBenchmark(const std::string name, const std::string params, const std::function<void()>& fn, 
+                                    const double itemsPerIter, const double minTimeSec = 0.1, const uint32_t samplesNo = 5U)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // warm up caches and estimate number of iterations per sample
+    uint64_t iterNo = 1U;
+    while(true)
+    {
+        const Clock::time_point start = Clock::now();
+        for (uint64_t i = 0; i < iterNo; ++i)
+        {
+            fn();
+        }
+        const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+        if((elapsed >= (minTimeSec / samplesNo)) || (iterNo >= (1ULL << 30)))
+        {
+            break;
+        }
+
+        iterNo *= 2U;
+    }
+
+    std::vector<double> samples;
+    for (uint32_t s = 0; s < samplesNo; ++s)
+    {
+        const Clock::time_point start = Clock::now();
+        for (uint64_t i = 0; i < iterNo; ++i)
+        {
+            fn();
+        }
+        samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterNo);
+    }
+
+    std::nth_element(samples.begin(), samples.begin() + (samples.size() / 2), samples.end());
+    const double nsPerIter = samples[samples.size() / 2];
+
+    BenchmarkResult result { name, params, nsPerIter, itemsPerIter * 1e9 / nsPerIter };
+
+    std::cout << name << " [" << params << "] -> " << nsPerIter << " ns/iter, " << result.itemsPerSec << " items/s" << std::endl;
+
+    return result;
+}
+
+// Write benchmark results as CSV
+inline void writeCsv(std::ostream& out, const std::vector<BenchmarkResult>& results)
+{
+    out << "name,params,ns_per_iter,items_per_sec" << std::endl;
+
+    for (const BenchmarkResult& r : results)
+    {
+        out << r.name << "," << r.params << "," << r.nsPerIter << "," << r.itemsPerSec << std::endl;
+    }
+}
+
+// Write benchmark results as JSON
+inline void writeJson(std::ostream& out, const std::vector<BenchmarkResult>& results)
+{
+    out << "[" << std::endl;
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchmarkResult& r = results[i];
+        out << "  {\"name\": \"" << r.name << "\", \"params\": \"" << r.params << "\", \"ns_per_iter\": " << r.nsPerIter 
+            << ", \"items_per_sec\": " << r.itemsPerSec << "}" << ((i + 1) < results.size() ? "," : "") << std::endl;
+    }
+
+    out << "]" << std::endl;
+}
+
+// Read baseline results previously written by writeCsv()
+// Return value: map (name,params) -> ns per iteration
+inline std::map<std::string, double> readCsvBaseline(const std::string path)
+{
+    std::map<std::string, double> baseline;
+    std::ifstream in(path);
+
+    if(false == in.is_open())
+    {
+        throw std::runtime_error("Baseline file " + path + " cannot be opened!");
+    }
+
+    std::string line;
+    getline(in, line); // skip header
+
+    while(getline(in, line))
+    {
+        std::stringstream s(line);
+        std::string name, params, nsPerIter;
+
+        getline(s, name, ',');
+        getline(s, params, ',');
+        getline(s, nsPerIter, ',');
+
+        if(false == nsPerIter.empty())
+        {
+            baseline[name + "," + params] = std::stod(nsPerIter);
+        }
+    }
+
+    return baseline;
+}
+
+// Compare results to the baseline and report each case slower than the baseline by more than tolerance
+// Return value: number of regressions
+inline uint32_t compareToBaseline(const std::vector<BenchmarkResult>& results, const std::map<std::string, double>& baseline, const double tolerance)
+{
+    uint32_t regressionsNo = 0U;
+
+    for (const BenchmarkResult& r : results)
+    {
+        auto it = baseline.find(r.name + "," + r.params);
+
+        if(baseline.end() == it)
+        {
+            continue;
+        }
+
+        const double ratio = r.nsPerIter / it->second;
+
+        if(ratio > (1.0 + tolerance))
+        {
+            std::cout << "REGRESSION: " << r.name << " [" << r.params << "] " << it->second << " ns -> " << r.nsPerIter 
+                      << " ns (" << ((ratio - 1.0) * 100.0) << "% slower)" << std::endl;
+            ++regressionsNo;
+        }
+    }
+
+    return regressionsNo;
+}
+
+#endif
@@ -1,13 +1,11 @@
 #include <iostream>
-#include <fstream>
 #include <string>
-#include <sstream>
 #include <tuple>
 #include "matplot/matplot.h"
 #include "NNFramework/NNFramework"
 
 // Function that is specific to the given problem
-void plotData(std::tuple<Eigen::VectorXd, Eigen::VectorXd, Eigen::VectorXd> data)
+void plotData(std::tuple<NNFramework::Vector, NNFramework::Vector, NNFramework::Vector> data)
 {
     using namespace matplot;
     auto f = figure(true);
@@ -24,7 +22,7 @@ void plotData(std::tuple<Eigen::VectorXd, Eigen::VectorXd, Eigen::VectorXd> data
 }
 
 // Function that is specific to the given problem
-void plotModelHistory(double epoch, std::tuple<Eigen::VectorXd, Eigen::VectorXd> modelHistory)
+void plotModelHistory(double epoch, std::tuple<NNFramework::Vector, NNFramework::Vector> modelHistory)
 {
     using namespace matplot;
     auto f = figure(true);
@@ -46,18 +44,18 @@ void plotModelHistory(double epoch, std::tuple<Eigen::VectorXd, Eigen::VectorXd>
 
 // used for sorting pairs of (xi, yi)
 // Function is specific for the given input format in data/input_data.txt
-std::tuple<Eigen::MatrixXd, Eigen::MatrixXd> sortData(Eigen::VectorXd inData, Eigen::VectorXd outData)
+std::tuple<NNFramework::Matrix, NNFramework::Matrix> sortData(NNFramework::Vector inData, NNFramework::Vector outData)
 {
 
     if(inData.size() != outData.size())
     {
-        throw "Size of the input Eigen::VectorXd's are not the same! Data cannot be sorted.";
+        throw "Size of the input NNFramework::Vector's are not the same! Data cannot be sorted.";
     }
     else
     {  
-        std::map<double, double> data;
-        Eigen::MatrixXd inDataSorted(inData.rows(), inData.cols());
-        Eigen::MatrixXd outDataSorted(outData.rows(), outData.cols());
+        std::map<NNFramework::Scalar, NNFramework::Scalar> data;
+        NNFramework::Matrix inDataSorted(inData.rows(), inData.cols());
+        NNFramework::Matrix outDataSorted(outData.rows(), outData.cols());
 
         for (uint32_t i = 0; i < inData.size(); ++i)
         {   
@@ -75,48 +73,3 @@ std::tuple<Eigen::MatrixXd, Eigen::MatrixXd> sortData(Eigen::VectorXd inData, Ei
         return std::make_tuple(inData, outData);
     }
 }
-
-// Load data from the input file to Eigen::MatrixXd's
-// Function is specific for the given input format in data/input_data.txt
-// where delimiter is blank space character ' '
-std::tuple<Eigen::MatrixXd, Eigen::MatrixXd> loadData(const std::string path, uint32_t sampleNo, uint8_t inCol, uint8_t expCol)
-{
-    std::fstream inputFile;
-
-    inputFile.open(path, std::ios::in);
-
-    if (inputFile.is_open())
-    { 
-        std::string line;
-        Eigen::MatrixXd inData = Eigen::MatrixXd::Zero(sampleNo, inCol);
-        Eigen::MatrixXd expData = Eigen::MatrixXd::Zero(sampleNo, expCol);
-
-        uint32_t i = 0;
-        while(getline(inputFile, line)) // parse one line of the file
-        {
-            std::stringstream s(line);
-
-            for(uint32_t j = 0; j < (inCol + expCol); ++j)
-            {
-                if(j < inCol)
-                {
-                    s >> inData(i, j);
-                }
-                else
-                {
-                    s >> expData(i, j - inCol);
-                }
-            }
-            ++i;
-        }
-
-        inputFile.close(); // close the file object.
-
-        return std::make_tuple(inData, expData);
-    }
-    else
-    {
-        throw std::runtime_error("Input file is not opened.");
-    }
-}
-
@@ -1,15 +1,37 @@
 #ifndef NNFRAMEWORK_COMMON_HPP
 #define NNFRAMEWORK_COMMON_HPP
 
+#include <cstdint>
+#include "../Eigen/Dense"
+
 // Common.hpp -> place for defining common things among the NNFramework
 
 constexpr uint32_t NNFRAMEWORK_ZERO = 0U;
 constexpr uint32_t MATRIX_COL_INIT_VAL = 1U;
 
+// Maximum number of data rows propagated trough the model at once during prediction
+constexpr uint32_t PREDICT_TILE_ROWS = 1024U;
+
 #define INPUT_LAYER_IDX      (0U)
-#define OUTPUT_LAYER_IDX(noOfLayers) (noOfLayers - 1) // forgive me my ugly 'C' past. :) 
+#define OUTPUT_LAYER_IDX(noOfLayers) (noOfLayers - 1) // forgive me my ugly 'C' past. :)
 
 #define PREVIOUS_LAYER_IDX(currentIdx) (currentIdx - 1)
 #define NEXT_LAYER_IDX(currentIdx) (currentIdx + 1)
 
-#endif
\ No newline at end of file
+namespace NNFramework
+{
+    // Scalar type used for weights, biases, activations, gradients and data trough the whole NNFramework.
+    // Selected at build time with the NNFRAMEWORK_USE_FLOAT32 CMake option (float32), double otherwise.
+    // float32 halves the memory footprint of the model and data and doubles the SIMD lanes used by Eigen.
+#ifdef NNFRAMEWORK_USE_FLOAT32
+    using Scalar = float;
+#else
+    using Scalar = double;
+#endif
+
+    // Dynamic matrix and column vector of NNFramework Scalar type
+    using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+    using Vector = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+}
+
+#endif
@@ -0,0 +1,392 @@
+#ifndef ACTIVATION_KERNELS_CORE_HPP
+#define ACTIVATION_KERNELS_CORE_HPP
+
+#include "../Eigen/Dense"
+#include "../Common/Common.hpp"
+
+namespace NNFramework
+{
+    namespace Activations
+    {
+        // Vectorized kernels of the activations: polynomial kernels of the FAST accuracy mode of the exp based activations
+        // and select based kernels of the piecewise activations
+        // Kernels are written with the Eigen packet primitives, thus a single kernel serves scalars and every SIMD packet
+        // type of Eigen (SSE, AVX, NEON). Kernel operators are applied by x.array().unaryExpr(op), which evaluates
+        // the whole kernel per packet in a single pass straight into the output, regardless of the compiler floating point flags.
+        namespace Kernels
+        {
+            // e^x, relative error below 1e-7 (double), 3e-7 (float)
+            // x = n * ln(2) + r, |r| <= ln(2) / 2 -> e^x = 2^n * e^r
+            // r is reduced with ln(2) split in two parts (Cody-Waite), thus it stays accurate for large |x|
+            // e^r is a degree 5 minimax polynomial (relative error 7.5e-8), 2^n is set in the exponent bits by pldexp()
+            // x is clamped to the normal range of 2^n: e^x of very large |x| gives a positive value close to
+            // 2^(min_exponent - 1) or 2^(max_exponent - 1) instead of 0 or inf, |r| stays in range for any x
+            template<class Packet>
+            inline Packet pfastExp(const Packet& x)
+            {
+                using namespace Eigen::internal;
+                using T = typename unpacket_traits<Packet>::type;
+
+                // adding 1.5 * 2^(mantissa bits) rounds to the nearest integer
+                const Packet roundMagic = pset1<Packet>(static_cast<T>(1.5) * static_cast<T>(1ULL << (Eigen::NumTraits<T>::digits() - 1)));
+                const Packet minX = pset1<Packet>(static_cast<T>((Eigen::NumTraits<T>::min_exponent() - 1) * 0.6931471805599453));
+                const Packet maxX = pset1<Packet>(static_cast<T>((Eigen::NumTraits<T>::max_exponent() - 1) * 0.6931471805599453));
+
+                const Packet xc = pmin(pmax(x, minX), maxX);
+
+                Packet n = pmul(xc, pset1<Packet>(static_cast<T>(1.4426950408889634)));   // log2(e)
+                n = psub(padd(n, roundMagic), roundMagic);
+
+                // ln(2) = 0.693359375 - 2.1219444005471377e-4, n * 0.693359375 is exact
+                Packet r = pmadd(n, pset1<Packet>(static_cast<T>(-0.693359375)), xc);
+                r = pmadd(n, pset1<Packet>(static_cast<T>(2.1219444005471377e-4)), r);
+
+                Packet p = pset1<Packet>(static_cast<T>(0.008297655080440131));
+                p = pmadd(p, r, pset1<Packet>(static_cast<T>(0.041915381991735355)));
+                p = pmadd(p, r, pset1<Packet>(static_cast<T>(0.166675747287549)));
+                p = pmadd(p, r, pset1<Packet>(static_cast<T>(0.4999889485122158)));
+                p = pmadd(p, r, pset1<Packet>(static_cast<T>(0.999999691991516)));
+                p = pmadd(p, r, pset1<Packet>(static_cast<T>(1.0000000716546822)));
+
+                return pldexp(p, n);
+            }
+
+            // ln(1 + u) for u in [0, 1], absolute error below 2e-8
+            // ln(1 + u) = 2 * atanh(s), s = u / (2 + u) <= 1/3, odd series of atanh up to s^13
+            template<class Packet>
+            inline Packet plog1pUnit(const Packet& u)
+            {
+                using namespace Eigen::internal;
+                using T = typename unpacket_traits<Packet>::type;
+
+                const Packet s = pdiv(u, padd(pset1<Packet>(static_cast<T>(2.0)), u));
+                const Packet s2 = pmul(s, s);
+
+                Packet p = pset1<Packet>(static_cast<T>(1.0 / 13.0));
+                p = pmadd(p, s2, pset1<Packet>(static_cast<T>(1.0 / 11.0)));
+                p = pmadd(p, s2, pset1<Packet>(static_cast<T>(1.0 / 9.0)));
+                p = pmadd(p, s2, pset1<Packet>(static_cast<T>(1.0 / 7.0)));
+                p = pmadd(p, s2, pset1<Packet>(static_cast<T>(1.0 / 5.0)));
+                p = pmadd(p, s2, pset1<Packet>(static_cast<T>(1.0 / 3.0)));
+                p = pmadd(p, s2, pset1<Packet>(static_cast<T>(1.0)));
+
+                return pmul(pmul(pset1<Packet>(static_cast<T>(2.0)), s), p);
+            }
+
+            // 1 / (1 + e^(-x))
+            template<class Packet>
+            inline Packet pfastSigmoid(const Packet& x)
+            {
+                using namespace Eigen::internal;
+                using T = typename unpacket_traits<Packet>::type;
+
+                const Packet one = pset1<Packet>(static_cast<T>(1.0));
+
+                return pdiv(one, padd(one, pfastExp(pnegate(x))));
+            }
+
+            // tanh(x) = 1 - 2 / (1 + e^(2x))
+            template<class Packet>
+            inline Packet pfastTanh(const Packet& x)
+            {
+                using namespace Eigen::internal;
+                using T = typename unpacket_traits<Packet>::type;
+
+                const Packet one = pset1<Packet>(static_cast<T>(1.0));
+                const Packet two = pset1<Packet>(static_cast<T>(2.0));
+
+                return psub(one, pdiv(two, padd(one, pfastExp(pmul(two, x)))));
+            }
+
+            // ln(1 + e^x) = max(x, 0) + ln(1 + e^(-|x|)), does not overflow for large x
+            template<class Packet>
+            inline Packet pfastSoftplus(const Packet& x)
+            {
+                using namespace Eigen::internal;
+                using T = typename unpacket_traits<Packet>::type;
+
+                return padd(pmax(x, pset1<Packet>(static_cast<T>(0.0))), plog1pUnit(pfastExp(pnegate(pabs(x)))));
+            }
+
+            // Operators of the kernels for unaryExpr(), scalars are evaluated by the same kernel
+            // absolute error of the activations and their derivatives: below 1e-7 (double), 5e-7 (float)
+            struct FastSigmoidOp
+            {
+                Scalar operator()(const Scalar& x) const { return packetOp(x); }
+
+                template<class Packet>
+                Packet packetOp(const Packet& x) const { return pfastSigmoid(x); }
+            };
+
+            // f(x) * (1 - f(x))
+            struct FastSigmoidDerivativeOp
+            {
+                Scalar operator()(const Scalar& x) const { return packetOp(x); }
+
+                template<class Packet>
+                Packet packetOp(const Packet& x) const
+                {
+                    const Packet f = pfastSigmoid(x);
+
+                    return Eigen::internal::pmul(f, Eigen::internal::psub(Eigen::internal::pset1<Packet>(static_cast<Scalar>(1.0)), f));
+                }
+            };
+
+            struct FastTanhOp
+            {
+                Scalar operator()(const Scalar& x) const { return packetOp(x); }
+
+                template<class Packet>
+                Packet packetOp(const Packet& x) const { return pfastTanh(x); }
+            };
+
+            // 1 - f(x)^2
+            struct FastTanhDerivativeOp
+            {
+                Scalar operator()(const Scalar& x) const { return packetOp(x); }
+
+                template<class Packet>
+                Packet packetOp(const Packet& x) const
+                {
+                    const Packet f = pfastTanh(x);
+
+                    return Eigen::internal::psub(Eigen::internal::pset1<Packet>(static_cast<Scalar>(1.0)), Eigen::internal::pmul(f, f));
+                }
+            };
+
+            struct FastSoftplusOp
+            {
+                Scalar operator()(const Scalar& x) const { return packetOp(x); }
+
+                template<class Packet>
+                Packet packetOp(const Packet& x) const { return pfastSoftplus(x); }
+            };
+
+            // e^(-|x|), shared by the softplus and its derivative (see Softplus.activateWithDerivative())
+            struct FastExpNegAbsOp
+            {
+                Scalar operator()(const Scalar& x) const { return packetOp(x); }
+
+                template<class Packet>
+                Packet packetOp(const Packet& x) const { return pfastExp(Eigen::internal::pnegate(Eigen::internal::pabs(x))); }
+            };
+
+            // ln(1 + e^x) = max(x, 0) + ln(1 + e^(-|x|)) from x and e = e^(-|x|)
+            struct FastSoftplusFromExpOp
+            {
+                Scalar operator()(const Scalar& x, const Scalar& e) const { return packetOp(x, e); }
+
+                template<class Packet>
+                Packet packetOp(const Packet& x, const Packet& e) const
+                {
+                    using namespace Eigen::internal;
+
+                    return padd(pmax(x, pset1<Packet>(static_cast<Scalar>(0.0))), plog1pUnit(e));
+                }
+            };
+
+            // Derivative of softplus 1 / (1 + e^(-x)) from x and e = e^(-|x|): 1 / (1 + e) for x >= 0, e / (1 + e) otherwise
+            // used when e^(-|x|) is already calculated for the softplus, thus no exp is evaluated
+            struct SoftplusDerivativeFromExpOp
+            {
+                Scalar operator()(const Scalar& x, const Scalar& e) const { return packetOp(x, e); }
+
+                template<class Packet>
+                Packet packetOp(const Packet& x, const Packet& e) const
+                {
+                    using namespace Eigen::internal;
+
+                    const Packet one = pset1<Packet>(static_cast<Scalar>(1.0));
+
+                    return pdiv(pselect(pcmp_lt(x, pset1<Packet>(static_cast<Scalar>(0.0))), e, one), padd(one, e));
+                }
+            };
+
+            // Piecewise kernels are branchless: both pieces are evaluated and the result is selected per element
+            // by the mask of x > 0, the piece of x <= 0 defines the (sub)gradient at the breakpoint
+
+            // 1 for x > 0, 0 otherwise
+            struct ReluDerivativeOp
+            {
+                Scalar operator()(const Scalar& x) const { return packetOp(x); }
+
+                template<class Packet>
+                Packet packetOp(const Packet& x) const
+                {
+                    using namespace Eigen::internal;
+
+                    const Packet zero = pset1<Packet>(static_cast<Scalar>(0.0));
+
+                    return pselect(pcmp_lt(zero, x), pset1<Packet>(static_cast<Scalar>(1.0)), zero);
+                }
+            };
+
+            // x for x > 0, slope * x otherwise
+            struct LeakyReluOp
+            {
+                Scalar slope;
+
+                Scalar operator()(const Scalar& x) const { return packetOp(x); }
+
+                template<class Packet>
+                Packet packetOp(const Packet& x) const
+                {
+                    using namespace Eigen::internal;
+
+                    return pselect(pcmp_lt(pset1<Packet>(static_cast<Scalar>(0.0)), x), x, pmul(pset1<Packet>(slope), x));
+                }
+            };
+
+            // 1 for x > 0, slope otherwise
+            struct LeakyReluDerivativeOp
+            {
+                Scalar slope;
+
+                Scalar operator()(const Scalar& x) const { return packetOp(x); }
+
+                template<class Packet>
+                Packet packetOp(const Packet& x) const
+                {
+                    using namespace Eigen::internal;
+
+                    return pselect(pcmp_lt(pset1<Packet>(static_cast<Scalar>(0.0)), x), pset1<Packet>(static_cast<Scalar>(1.0)), pset1<Packet>(slope));
+                }
+            };
+
+            // x for x > 0, alpha * (e^x - 1) otherwise
+            // e^x is taken of min(x, 0), thus it does not overflow for the large x of the other piece
+            struct EluOp
+            {
+                Scalar alpha;
+
+                Scalar operator()(const Scalar& x) const { return packetOp(x); }
+
+                template<class Packet>
+                Packet packetOp(const Packet& x) const
+                {
+                    using namespace Eigen::internal;
+
+                    const Packet zero = pset1<Packet>(static_cast<Scalar>(0.0));
+                    const Packet negative = pmul(pset1<Packet>(alpha), psub(pexp(pmin(x, zero)), pset1<Packet>(static_cast<Scalar>(1.0))));
+
+                    return pselect(pcmp_lt(zero, x), x, negative);
+                }
+            };
+
+            // 1 for x > 0, alpha * e^x otherwise
+            struct EluDerivativeOp
+            {
+                Scalar alpha;
+
+                Scalar operator()(const Scalar& x) const { return packetOp(x); }
+
+                template<class Packet>
+                Packet packetOp(const Packet& x) const
+                {
+                    using namespace Eigen::internal;
+
+                    const Packet zero = pset1<Packet>(static_cast<Scalar>(0.0));
+                    const Packet negative = pmul(pset1<Packet>(alpha), pexp(pmin(x, zero)));
+
+                    return pselect(pcmp_lt(zero, x), pset1<Packet>(static_cast<Scalar>(1.0)), negative);
+                }
+            };
+
+            // Derivative of Elu from its input x and output y: 1 for x > 0, alpha * e^x = y + alpha otherwise
+            // used when the output is already calculated, thus e^x is not evaluated again
+            struct EluDerivativeFromOutputOp
+            {
+                Scalar alpha;
+
+                Scalar operator()(const Scalar& x, const Scalar& y) const { return packetOp(x, y); }
+
+                template<class Packet>
+                Packet packetOp(const Packet& x, const Packet& y) const
+                {
+                    using namespace Eigen::internal;
+
+                    return pselect(pcmp_lt(pset1<Packet>(static_cast<Scalar>(0.0)), x), pset1<Packet>(static_cast<Scalar>(1.0)), padd(y, pset1<Packet>(alpha)));
+                }
+            };
+
+            // slope for |x| < limit, 0 otherwise
+            struct HardSigmoidDerivativeOp
+            {
+                Scalar slope;
+                Scalar limit;
+
+                Scalar operator()(const Scalar& x) const { return packetOp(x); }
+
+                template<class Packet>
+                Packet packetOp(const Packet& x) const
+                {
+                    using namespace Eigen::internal;
+
+                    return pselect(pcmp_lt(pabs(x), pset1<Packet>(limit)), pset1<Packet>(slope), pset1<Packet>(static_cast<Scalar>(0.0)));
+                }
+            };
+        }
+    }
+}
+
+// Kernel operators are vectorized by Eigen
+namespace Eigen
+{
+    namespace internal
+    {
+        template<class Op> struct nnframework_kernel_traits
+        {
+            enum
+            {
+                Cost = 20 * NumTraits<NNFramework::Scalar>::MulCost,
+                PacketAccess = packet_traits<NNFramework::Scalar>::HasDiv && packet_traits<NNFramework::Scalar>::HasMin &&
+                               packet_traits<NNFramework::Scalar>::HasMax
+            };
+        };
+
+        template<> struct functor_traits<NNFramework::Activations::Kernels::FastSigmoidOp> : nnframework_kernel_traits<NNFramework::Activations::Kernels::FastSigmoidOp> {};
+        template<> struct functor_traits<NNFramework::Activations::Kernels::FastSigmoidDerivativeOp> : nnframework_kernel_traits<NNFramework::Activations::Kernels::FastSigmoidDerivativeOp> {};
+        template<> struct functor_traits<NNFramework::Activations::Kernels::FastTanhOp> : nnframework_kernel_traits<NNFramework::Activations::Kernels::FastTanhOp> {};
+        template<> struct functor_traits<NNFramework::Activations::Kernels::FastTanhDerivativeOp> : nnframework_kernel_traits<NNFramework::Activations::Kernels::FastTanhDerivativeOp> {};
+        template<> struct functor_traits<NNFramework::Activations::Kernels::FastSoftplusOp> : nnframework_kernel_traits<NNFramework::Activations::Kernels::FastSoftplusOp> {};
+        template<> struct functor_traits<NNFramework::Activations::Kernels::FastExpNegAbsOp> : nnframework_kernel_traits<NNFramework::Activations::Kernels::FastExpNegAbsOp> {};
+        template<> struct functor_traits<NNFramework::Activations::Kernels::FastSoftplusFromExpOp> : nnframework_kernel_traits<NNFramework::Activations::Kernels::FastSoftplusFromExpOp> {};
+
+        template<> struct functor_traits<NNFramework::Activations::Kernels::SoftplusDerivativeFromExpOp>
+        {
+            enum
+            {
+                Cost = 4 * NumTraits<NNFramework::Scalar>::AddCost + scalar_div_cost<NNFramework::Scalar, packet_traits<NNFramework::Scalar>::HasDiv>::value,
+                PacketAccess = packet_traits<NNFramework::Scalar>::HasDiv && packet_traits<NNFramework::Scalar>::HasCmp
+            };
+        };
+
+        template<class Op> struct nnframework_select_kernel_traits
+        {
+            enum
+            {
+                Cost = 4 * NumTraits<NNFramework::Scalar>::AddCost,
+                PacketAccess = packet_traits<NNFramework::Scalar>::HasCmp && packet_traits<NNFramework::Scalar>::HasMin &&
+                               packet_traits<NNFramework::Scalar>::HasAbs
+            };
+        };
+
+        template<class Op> struct nnframework_exp_select_kernel_traits
+        {
+            enum
+            {
+                Cost = 4 * NumTraits<NNFramework::Scalar>::AddCost + functor_traits<scalar_exp_op<NNFramework::Scalar>>::Cost,
+                PacketAccess = nnframework_select_kernel_traits<Op>::PacketAccess && packet_traits<NNFramework::Scalar>::HasExp
+            };
+        };
+
+        template<> struct functor_traits<NNFramework::Activations::Kernels::ReluDerivativeOp> : nnframework_select_kernel_traits<NNFramework::Activations::Kernels::ReluDerivativeOp> {};
+        template<> struct functor_traits<NNFramework::Activations::Kernels::LeakyReluOp> : nnframework_select_kernel_traits<NNFramework::Activations::Kernels::LeakyReluOp> {};
+        template<> struct functor_traits<NNFramework::Activations::Kernels::LeakyReluDerivativeOp> : nnframework_select_kernel_traits<NNFramework::Activations::Kernels::LeakyReluDerivativeOp> {};
+        template<> struct functor_traits<NNFramework::Activations::Kernels::EluOp> : nnframework_exp_select_kernel_traits<NNFramework::Activations::Kernels::EluOp> {};
+        template<> struct functor_traits<NNFramework::Activations::Kernels::EluDerivativeOp> : nnframework_exp_select_kernel_traits<NNFramework::Activations::Kernels::EluDerivativeOp> {};
+        template<> struct functor_traits<NNFramework::Activations::Kernels::EluDerivativeFromOutputOp> : nnframework_select_kernel_traits<NNFramework::Activations::Kernels::EluDerivativeFromOutputOp> {};
+        template<> struct functor_traits<NNFramework::Activations::Kernels::HardSigmoidDerivativeOp> : nnframework_select_kernel_traits<NNFramework::Activations::Kernels::HardSigmoidDerivativeOp> {};
+    }
+}
+#endif
@@ -1,9 +1,14 @@
 #ifndef ACTIVATIONS_CORE_HPP
 #define ACTIVATIONS_CORE_HPP
 
+#include <charconv>
 #include <cmath>
 #include <string>
 #include <iostream>
+#include <memory>
+#include "../Eigen/Dense"
+#include "../Common/Common.hpp"
+#include "ActivationKernels.hpp"
 
 namespace NNFramework
 {
@@ -12,24 +17,53 @@ namespace NNFramework
 
         template<class TypeName> struct ActivationType { typedef TypeName T; }; 
 
+        // Accuracy mode of the exp based activations (Sigmoid, Tanh, Softplus)
+        // EXACT -> Eigen array functions, accurate to a few ulp
+        // FAST -> polynomial approximations of Kernels, absolute error of the activation below 1e-7 (double), 5e-7 (float)
+        // FAST mode is selected by constructing the activation, e.g. Layers::Dense(20, std::make_unique<Activations::Sigmoid>(Activations::FAST))
+        enum Accuracy : uint8_t
+        {
+            EXACT = 0U,
+            FAST = 1U
+        };
+
         struct ActivationFunctor
         {
             virtual std::string name() const = 0;
+
+            virtual ~ActivationFunctor() = default;
             
-            Eigen::MatrixXd operator()(const Eigen::MatrixXd& x, const bool derive = false) const
+            Matrix operator()(const Eigen::Ref<const Matrix>& x, const bool derive = false) const
             {
+                Matrix result(x.rows(), x.cols());
+
                 if(derive)
                 {
-                    return derivative(x);
+                    derivative(x, result);
                 }
                 else
                 {
-                    return activate(x);
+                    activate(x, result);
                 }
+
+                return result;
             }
             
-            virtual Eigen::MatrixXd activate(const Eigen::MatrixXd& x) const = 0;
-            virtual Eigen::MatrixXd derivative(const Eigen::MatrixXd& x) const = 0;
+            // param: x -> input
+            // param: y -> output, has to be of the same size as x
+            // results are written directly into y, no memory is allocated
+            virtual void activate(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y) const = 0;
+            virtual void derivative(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y) const = 0;
+
+            // Activation and derivative of the same input at once, used by the forward pass during training
+            // param: dy -> derivative output, has to be of the same size as x
+            // activations with a derivative expressed by their output override it, thus the derivative is taken
+            // from y without evaluating the activation again
+            virtual void activateWithDerivative(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y, Eigen::Ref<Matrix> dy) const
+            {
+                activate(x, y);
+                derivative(x, dy);
+            }
         };
 
         struct InputActivation final : ActivationFunctor 
@@ -39,44 +73,200 @@ namespace NNFramework
                 return "InputActivation";
             }
 
-            Eigen::MatrixXd activate(const Eigen::MatrixXd& x) const override 
+            void activate(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y) const override 
             { 
-                return x;
+                y = x;
             }
 
-            Eigen::MatrixXd derivative(const Eigen::MatrixXd& x) const override 
+            void derivative(const Eigen::Ref<const Matrix>&, Eigen::Ref<Matrix> y) const override 
             {
-                Eigen::MatrixXd retVec = Eigen::MatrixXd::Zero(x.rows(), x.cols());
-                return retVec;
+                y.setZero();
             }
         };
 
         struct Sigmoid final : ActivationFunctor
         {
-            std::string name() const override
-            {
-                return "Sigmoid";
-            }
+            public:
+                explicit Sigmoid(const Accuracy accuracy = EXACT) : mAccuracy(accuracy) {}
 
-            Eigen::MatrixXd activate(const Eigen::MatrixXd& x) const override 
-            { 
-                Eigen::MatrixXd retVec = x;
-                
-                retVec *= -1.0;
-                retVec = retVec.unaryExpr([](const double& el) { return std::exp(el); });
+                std::string name() const override
+                {
+                    return (FAST == mAccuracy) ? "SigmoidFast" : "Sigmoid";
+                }
 
-                retVec = retVec + Eigen::MatrixXd::Ones(retVec.rows(), retVec.cols());
+                // f(x) = 1 / (1 + e^(-x))
+                void activate(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y) const override 
+                { 
+                    if(FAST == mAccuracy)
+                    {
+                        y.array() = x.array().unaryExpr(Kernels::FastSigmoidOp());
+                    }
+                    else
+                    {
+                        y = ((-x.array()).exp() + static_cast<Scalar>(1.0)).inverse().matrix();
+                    }
+                }
 
-                return retVec.unaryExpr([](const double& el){ return 1.0 / el; });
-            }
+                // f'(x) = f(x) * (1 - f(x))
+                void derivative(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y) const override 
+                {
+                    if(FAST == mAccuracy)
+                    {
+                        y.array() = x.array().unaryExpr(Kernels::FastSigmoidDerivativeOp());
+                    }
+                    else
+                    {
+                        activate(x, y);
+                        y.array() *= (static_cast<Scalar>(1.0) - y.array());
+                    }
+                }
+
+                // f'(x) = f(x) * (1 - f(x)) from the output
+                void activateWithDerivative(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y, Eigen::Ref<Matrix> dy) const override
+                {
+                    activate(x, y);
+                    dy.array() = y.array() * (static_cast<Scalar>(1.0) - y.array());
+                }
+
+            private:
+                Accuracy mAccuracy;
+        };
+
+        struct Tanh final : ActivationFunctor
+        {
+            public:
+                explicit Tanh(const Accuracy accuracy = EXACT) : mAccuracy(accuracy) {}
+
+                std::string name() const override
+                {
+                    return (FAST == mAccuracy) ? "TanhFast" : "Tanh";
+                }
 
-            Eigen::MatrixXd derivative(const Eigen::MatrixXd& x) const override 
+                // f(x) = (e^x - e^(-x)) / (e^x + e^(-x))
+                void activate(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y) const override 
+                { 
+                    if(FAST == mAccuracy)
+                    {
+                        y.array() = x.array().unaryExpr(Kernels::FastTanhOp());
+                    }
+                    else
+                    {
+                        y.array() = x.array().tanh();
+                    }
+                }
+
+                // f'(x) = 1 - f(x)^2
+                void derivative(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y) const override 
+                {
+                    if(FAST == mAccuracy)
+                    {
+                        y.array() = x.array().unaryExpr(Kernels::FastTanhDerivativeOp());
+                    }
+                    else
+                    {
+                        activate(x, y);
+                        y.array() = static_cast<Scalar>(1.0) - y.array().square();
+                    }
+                }
+
+                // f'(x) = 1 - f(x)^2 from the output
+                void activateWithDerivative(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y, Eigen::Ref<Matrix> dy) const override
+                {
+                    activate(x, y);
+                    dy.array() = static_cast<Scalar>(1.0) - y.array().square();
+                }
+
+            private:
+                Accuracy mAccuracy;
+        };
+
+        struct Softplus final : ActivationFunctor
+        {
+            public:
+                explicit Softplus(const Accuracy accuracy = EXACT) : mAccuracy(accuracy) {}
+
+                std::string name() const override
+                {
+                    return (FAST == mAccuracy) ? "SoftplusFast" : "Softplus";
+                }
+
+                // f(x) = ln(1 + e^x) = max(x, 0) + ln(1 + e^(-|x|)), the latter does not overflow for large x
+                void activate(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y) const override 
+                { 
+                    if(FAST == mAccuracy)
+                    {
+                        y.array() = x.array().unaryExpr(Kernels::FastSoftplusOp());
+                    }
+                    else
+                    {
+                        y.array() = x.array().max(static_cast<Scalar>(0.0)) + (-x.array().abs()).exp().log1p();
+                    }
+                }
+
+                // f'(x) = 1 / (1 + e^(-x))
+                void derivative(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y) const override 
+                {
+                    if(FAST == mAccuracy)
+                    {
+                        y.array() = x.array().unaryExpr(Kernels::FastSigmoidOp());
+                    }
+                    else
+                    {
+                        y = ((-x.array()).exp() + static_cast<Scalar>(1.0)).inverse().matrix();
+                    }
+                }
+
+                // f(x) and f'(x) from the same e^(-|x|), one exp for both
+                // e^(-|x|) is kept in dy until the derivative is taken from it
+                void activateWithDerivative(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y, Eigen::Ref<Matrix> dy) const override
+                {
+                    if(FAST == mAccuracy)
+                    {
+                        dy.array() = x.array().unaryExpr(Kernels::FastExpNegAbsOp());
+                        y.array() = x.array().binaryExpr(dy.array(), Kernels::FastSoftplusFromExpOp());
+                    }
+                    else
+                    {
+                        dy.array() = (-x.array().abs()).exp();
+                        y.array() = x.array().max(static_cast<Scalar>(0.0)) + dy.array().log1p();
+                    }
+
+                    dy.array() = x.array().binaryExpr(dy.array(), Kernels::SoftplusDerivativeFromExpOp());
+                }
+
+            private:
+                Accuracy mAccuracy;
+        };
+
+        // Name of the activation with a parameter, e.g. LeakyRelu(0.2)
+        // the parameter is written in its shortest form which is read back to the same value
+        inline std::string parametrizedName(const std::string& name, const Scalar parameter)
+        {
+            char buffer[32];
+            const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), parameter);
+
+            return name + "(" + std::string(buffer, result.ptr) + ")";
+        }
+
+        // Read the parameter of the parametrized name written by parametrizedName()
+        // Return value: true if fullName is the name with a parameter
+        inline bool parseParametrizedName(const std::string& fullName, const std::string& name, Scalar& parameter)
+        {
+            if((fullName.size() < (name.size() + 2U)) || (0 != fullName.compare(0, name.size(), name)) ||
+               ('(' != fullName[name.size()]) || (')' != fullName.back()))
             {
-                Eigen::MatrixXd activated = activate(x);
-                return activated.cwiseProduct(Eigen::MatrixXd::Ones(activated.rows(), activated.cols()) - activated);
+                return false;
             }
-        };
 
+            const char* first = fullName.data() + name.size() + 1U;
+            const char* last = fullName.data() + fullName.size() - 1U;
+            const std::from_chars_result result = std::from_chars(first, last, parameter);
+
+            return (std::errc() == result.ec) && (last == result.ptr);
+        }
+
+        // Piecewise activations below are branchless, pieces are selected per element by the select based Kernels
+        // derivatives take a defined subgradient at the breakpoints, thus they never throw
         struct Relu final : ActivationFunctor
         {
             std::string name() const override
@@ -84,84 +274,139 @@ namespace NNFramework
                 return "Relu";
             }
 
-            Eigen::MatrixXd activate(const Eigen::MatrixXd& x) const override 
+            // f(x) = max(x, 0)
+            void activate(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y) const override 
             { 
-                Eigen::MatrixXd retVec = x.unaryExpr([](const double& el){ return std::max(0.0, el); });
-
-                return retVec;
+                y = x.cwiseMax(static_cast<Scalar>(0.0));
             }
 
-            Eigen::MatrixXd derivative(const Eigen::MatrixXd& x) const override 
+            // f'(x) = 1 for x > 0, 0 otherwise (subgradient 0 at x = 0)
+            void derivative(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y) const override 
             {
-                std::string fname = __FUNCTION__;
-
-                Eigen::MatrixXd retVec = x.unaryExpr(
-                    [fname](const double& el)
-                    {
-                        if(0.0 > el)
-                        {
-                            return 0.0;
-                        }
-                        else if (0.0 < el)
-                        {
-                            return 1.0;
-                        }
-                        else
-                        {
-                            std::cout << fname << ": ";
-                            throw std::runtime_error("Activation derivative undefined in zero!");    
-                        }
-                    }
-                );
-
-                return retVec;
+                y.array() = x.array().unaryExpr(Kernels::ReluDerivativeOp());
             }
         };
 
         struct LeakyRelu final : ActivationFunctor
         {
             public:
+                // slope of the negative part, f(x) = slope * x for x <= 0
+                // with slope other than 0.01 it is also called Parametric or Randomized ReLU as per: https://towardsdatascience.com/activation-functions-neural-networks-1cbd9f8d91d6
+                explicit LeakyRelu(const Scalar slope = DEFAULT_SLOPE) : mSlope(slope) {}
+
                 std::string name() const override
                 {
-                    return "LeakyRelu";
+                    return (DEFAULT_SLOPE == mSlope) ? "LeakyRelu" : parametrizedName("LeakyRelu", mSlope);
                 }
 
-                Eigen::MatrixXd activate(const Eigen::MatrixXd& x) const override 
+                // f(x) = x for x > 0, slope * x otherwise
+                void activate(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y) const override 
                 { 
-                    Eigen::MatrixXd retVec = x.unaryExpr([this](const double& el) { return (el >= 0.0) ? el : factor * el; } );
+                    y.array() = x.array().unaryExpr(Kernels::LeakyReluOp { mSlope });
+                }
 
-                    return retVec;
+                // f'(x) = 1 for x > 0, slope otherwise (subgradient slope at x = 0)
+                void derivative(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y) const override 
+                {
+                    y.array() = x.array().unaryExpr(Kernels::LeakyReluDerivativeOp { mSlope });
                 }
 
-                Eigen::MatrixXd derivative(const Eigen::MatrixXd& x) const override 
+                // Getters
+                Scalar get_mSlope() const noexcept { return mSlope; }
+
+            private:
+                static constexpr Scalar DEFAULT_SLOPE = static_cast<Scalar>(0.01);
+
+                Scalar mSlope;
+        };
+
+        struct Elu final : ActivationFunctor
+        {
+            public:
+                // f(x) = alpha * (e^x - 1) for x <= 0
+                explicit Elu(const Scalar alpha = DEFAULT_ALPHA) : mAlpha(alpha) {}
+
+                std::string name() const override
+                {
+                    return (DEFAULT_ALPHA == mAlpha) ? "Elu" : parametrizedName("Elu", mAlpha);
+                }
+
+                // f(x) = x for x > 0, alpha * (e^x - 1) otherwise
+                void activate(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y) const override 
+                { 
+                    y.array() = x.array().unaryExpr(Kernels::EluOp { mAlpha });
+                }
+
+                // f'(x) = 1 for x > 0, alpha * e^x otherwise (subgradient alpha at x = 0)
+                void derivative(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y) const override 
+                {
+                    y.array() = x.array().unaryExpr(Kernels::EluDerivativeOp { mAlpha });
+                }
+
+                // f'(x) = 1 for x > 0, f(x) + alpha otherwise, from the output
+                void activateWithDerivative(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y, Eigen::Ref<Matrix> dy) const override
+                {
+                    activate(x, y);
+                    dy.array() = x.array().binaryExpr(y.array(), Kernels::EluDerivativeFromOutputOp { mAlpha });
+                }
+
+                // Getters
+                Scalar get_mAlpha() const noexcept { return mAlpha; }
+
+            private:
+                static constexpr Scalar DEFAULT_ALPHA = static_cast<Scalar>(1.0);
+
+                Scalar mAlpha;
+        };
+
+        struct HardSigmoid final : ActivationFunctor
+        {
+            public:
+                std::string name() const override
                 {
-                    std::string fname = __FUNCTION__;
+                    return "HardSigmoid";
+                }
 
-                    Eigen::MatrixXd retVec = x.unaryExpr(
-                        [this, fname](const double& el)
-                        {
-                            if(0.0 < el)
-                            {
-                                return 1.0;
-                            }
-                            else if (0.0 > el)
-                            {
-                                return factor;
-                            }
-                            else
-                            {
-                                std::cout << fname << ": ";
-                                throw std::runtime_error("Activation derivative undefined in zero!");    
-                            }
-                        }
-                    );
+                // f(x) = min(max(0.2 * x + 0.5, 0), 1), piecewise linear approximation of Sigmoid
+                void activate(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y) const override 
+                { 
+                    y.array() = ((SLOPE * x.array()) + static_cast<Scalar>(0.5)).max(static_cast<Scalar>(0.0)).min(static_cast<Scalar>(1.0));
+                }
 
-                    return retVec;
+                // f'(x) = 0.2 for -2.5 < x < 2.5, 0 otherwise (subgradient 0 at x = +-2.5)
+                void derivative(const Eigen::Ref<const Matrix>& x, Eigen::Ref<Matrix> y) const override 
+                {
+                    y.array() = x.array().unaryExpr(Kernels::HardSigmoidDerivativeOp { SLOPE, LIMIT });
                 }
 
             private:
-                const double factor = 0.01; // f(y) = a*y -> when a is not 0.01 than it's called Randomized ReLU as per: https://towardsdatascience.com/activation-functions-neural-networks-1cbd9f8d91d6
+                static constexpr Scalar SLOPE = static_cast<Scalar>(0.2);
+                static constexpr Scalar LIMIT = static_cast<Scalar>(2.5);
         };
+
+        // Create activation functor from its name()
+        // used to restore layers of a model loaded from a file
+        inline std::unique_ptr<ActivationFunctor> makeActivation(const std::string& name)
+        {
+            if("InputActivation" == name) { return std::make_unique<InputActivation>(); }
+            if("Sigmoid" == name) { return std::make_unique<Sigmoid>(); }
+            if("SigmoidFast" == name) { return std::make_unique<Sigmoid>(FAST); }
+            if("Tanh" == name) { return std::make_unique<Tanh>(); }
+            if("TanhFast" == name) { return std::make_unique<Tanh>(FAST); }
+            if("Softplus" == name) { return std::make_unique<Softplus>(); }
+            if("SoftplusFast" == name) { return std::make_unique<Softplus>(FAST); }
+            if("Relu" == name) { return std::make_unique<Relu>(); }
+            if("LeakyRelu" == name) { return std::make_unique<LeakyRelu>(); }
+            if("Elu" == name) { return std::make_unique<Elu>(); }
+            if("HardSigmoid" == name) { return std::make_unique<HardSigmoid>(); }
+
+            Scalar parameter = static_cast<Scalar>(0.0);
+            if(true == parseParametrizedName(name, "LeakyRelu", parameter)) { return std::make_unique<LeakyRelu>(parameter); }
+            if(true == parseParametrizedName(name, "Elu", parameter)) { return std::make_unique<Elu>(parameter); }
+
+            std::cout << __FUNCTION__ << ": ";
+            throw std::runtime_error("Unknown activation function " + name + "!");
+        }
     }
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,142 @@
+#ifndef BATCHING_QUEUE_CORE_HPP
+#define BATCHING_QUEUE_CORE_HPP
+
+#include <memory>
+#include <vector>
+#include <deque>
+#include <chrono>
+#include <future>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <exception>
+#include "../Eigen/Dense"
+#include "Model.hpp"
+#include "InferenceContext.hpp"
+#include "../Common/Common.hpp"
+
+namespace NNFramework
+{
+    namespace Model
+    {
+        namespace BatchingQueue
+        {
+            // Statistics of the BatchingQueue since its construction
+            // latency percentiles are calculated over the last LATENCY_SAMPLES_NO requests
+            struct BatchingStats final
+            {
+                uint64_t requestsNo = 0U;       // number of completed requests
+                uint64_t failedNo = 0U;         // number of completed requests whose prediction or callback failed
+                uint64_t batchesNo = 0U;        // number of executed micro-batches
+                double meanBatchSize = 0.0;     // average number of requests per micro-batch
+                uint32_t maxBatchSize = 0U;     // largest executed micro-batch
+                uint32_t queueDepth = 0U;       // number of requests currently waiting in the queue
+                uint32_t maxQueueDepth = 0U;    // largest number of requests waiting in the queue at once
+                double p50LatencyUs = 0.0;      // median latency from submit to completion in microseconds
+                double p99LatencyUs = 0.0;      // 99th percentile latency from submit to completion in microseconds
+            };
+
+            // BatchingQueue collects single row prediction requests submitted concurrently by many threads
+            // into micro-batches and runs each micro-batch as one batched forward pass trough the shared Model.
+            // A micro-batch is executed as soon as maxBatchSize requests are waiting or the oldest waiting
+            // request has waited for maxWait, thus the added latency of each request is bounded by maxWait.
+            class BatchingQueue final
+            {
+                public:
+
+                    using Clock = std::chrono::steady_clock;
+
+                    // Called once the request is completed
+                    // error == nullptr -> outputRow is the predicted output row
+                    // error != nullptr -> prediction of the micro-batch failed, outputRow is empty
+                    using Callback = std::function<void(const Eigen::Ref<const Vector>& outputRow, const std::exception_ptr& error)>;
+
+                    // Number of latest request latencies kept for the latency percentiles
+                    static constexpr uint32_t LATENCY_SAMPLES_NO = 4096U;
+
+                    // Bind the queue to a compiled Model and start the batching thread
+                    BatchingQueue(std::shared_ptr<const Model> model, 
+                                  const uint32_t maxBatchSize = 32U, 
+                                  const std::chrono::microseconds maxWait = std::chrono::microseconds(500));
+
+                    // Delete default constructor
+                    BatchingQueue() = delete;
+
+                    // Delete copy constructor
+                    BatchingQueue(BatchingQueue& q) = delete;
+
+                    // Delete copy assignment operator
+                    BatchingQueue& operator=(const BatchingQueue& q) = delete;
+
+                    // Complete all waiting requests and stop the batching thread
+                    ~BatchingQueue();
+
+                    // Submit one input data row for prediction
+                    // returned future holds the predicted output row
+                    std::future<Vector> submit(const Eigen::Ref<const Vector>& inputRow);
+
+                    // Submit one input data row for prediction
+                    // callback is called from the batching thread with the predicted output row or with the error of the prediction
+                    // exception thrown by the callback is reported on std::cerr and counted in failedNo, it does not affect other requests
+                    void submit(const Eigen::Ref<const Vector>& inputRow, Callback callback);
+
+                    // Getters
+                    BatchingStats get_mStats() const;
+
+                private:
+
+                    // Single row prediction request waiting in the queue
+                    struct Request final
+                    {
+                        Vector inputRow;
+                        std::promise<Vector> promise;
+                        Callback callback;
+                        Clock::time_point submitTime;
+                    };
+
+                    std::shared_ptr<const Model> mModelPtr; // Shared trained Model
+                    InferenceContext::InferenceContext mContext; // Forward pass scratch space of the batching thread
+
+                    const uint32_t mMaxBatchSize;
+                    const std::chrono::microseconds mMaxWait;
+
+                    // micro-batch input and output data, one request per row
+                    Matrix mBatchInput;
+                    Matrix mBatchOutput;
+
+                    // requests waiting for the next micro-batch
+                    std::deque<Request> mRequests;
+                    std::mutex mRequestsMutex;
+                    std::condition_variable mRequestsCv;
+                    bool mStop;
+
+                    // requests of the micro-batch currently being executed
+                    std::vector<Request> mBatch;
+
+                    // statistics, latencies are kept in a ring buffer
+                    mutable std::mutex mStatsMutex;
+                    BatchingStats mStats;
+                    std::vector<double> mLatenciesUs;
+                    uint32_t mLatencyIdx;
+
+                    std::thread mBatchingThread;
+
+                    // Add request to the queue and wake up the batching thread
+                    void enqueue(Request&& request);
+
+                    // Batching thread loop
+                    void batchingLoop();
+
+                    // Run one micro-batch trough the Model and complete all of its requests
+                    void runBatch();
+
+                    // Pass the predicted output row or the error to the caller
+                    // returns false if the prediction or the callback failed
+                    bool completeRequest(Request& request, const Eigen::Ref<const Vector>& outputRow, const std::exception_ptr& error);
+            };
+        }
+    }
+}
+
+#endif
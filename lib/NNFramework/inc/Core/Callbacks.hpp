@@ -0,0 +1,86 @@
+#ifndef CALLBACKS_CORE_HPP
+#define CALLBACKS_CORE_HPP
+
+#include <string>
+#include <chrono>
+#include <iostream>
+#include "../Eigen/Dense"
+#include "../Common/Common.hpp"
+
+namespace NNFramework
+{
+    namespace Callbacks
+    {
+        // State of the training passed to the callbacks
+        // loss and metrics are accumulated over the data rows of the current epoch propagated so far
+        struct TrainingState final
+        {
+            uint32_t epoch;         // current epoch, starting from 0
+            uint32_t epochsNo;      // number of epochs of the training
+            uint32_t batch;         // current batch of the epoch, starting from 0
+            uint32_t rowsDone;      // number of data rows of the current epoch propagated so far
+            uint32_t rowsNo;        // number of data rows of one epoch, 0 if the data source does not know it in advance
+            Scalar loss;            // loss of the current epoch
+            double metrics;         // metrics of the current epoch
+        };
+
+        // Training observer
+        // hooks are called by modelFit() from a single thread, default implementation does nothing
+        // with Hogwild training onBatchEnd() is not called
+        struct CallbackFunctor
+        {
+            virtual std::string name() const = 0;
+
+            virtual ~CallbackFunctor() = default;
+
+            // called after each optimizer step
+            virtual void onBatchEnd(const TrainingState&) { }
+
+            // called after each epoch, loss and metrics are final values of the epoch saved in the ModelHistory
+            virtual void onEpochEnd(const TrainingState&) { }
+
+            // called once after the last epoch
+            virtual void onTrainEnd(const TrainingState&) { }
+        };
+
+        // Progress output of the training
+        // batch progress is written at most once per interval, each epoch result is always written
+        struct ProgressLogger final : CallbackFunctor
+        {
+            std::chrono::milliseconds interval;
+            std::ostream& out;
+
+            ProgressLogger(const std::chrono::milliseconds interval = std::chrono::milliseconds(500), std::ostream& out = std::cout) : 
+                interval(interval), out(out), lastLog(std::chrono::steady_clock::now()) { }
+
+            std::string name() const override
+            {
+                return "ProgressLogger";
+            }
+
+            void onBatchEnd(const TrainingState& state) override
+            {
+                const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+                if((now - lastLog) >= interval)
+                {
+                    lastLog = now;
+                    out << "Epoch: " << (state.epoch + 1) << "/" << state.epochsNo << " [" << state.rowsDone << "/" << state.rowsNo << "]" 
+                        << " -> Loss: " << state.loss << " Accuracy: " << state.metrics << "\r";
+                    out.flush();
+                }
+            }
+
+            void onEpochEnd(const TrainingState& state) override
+            {
+                lastLog = std::chrono::steady_clock::now();
+                out << "Epoch: " << (state.epoch + 1) << "/" << state.epochsNo << " -> Loss: " << state.loss << " Accuracy: " << state.metrics << std::endl;
+            }
+
+            private:
+                std::chrono::steady_clock::time_point lastLog;
+        };
+    }
+}
+
+#endif
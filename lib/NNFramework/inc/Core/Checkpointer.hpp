@@ -0,0 +1,125 @@
+#ifndef CHECKPOINTER_CORE_HPP
+#define CHECKPOINTER_CORE_HPP
+
+#include <string>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "../Eigen/Dense"
+#include "Callbacks.hpp"
+#include "Model.hpp"
+#include "../Common/Common.hpp"
+
+namespace NNFramework
+{
+    namespace Model
+    {
+        namespace Checkpointer
+        {
+            // Periodic background checkpoints of the Model weights during modelFit()
+            //
+            // Registered as a training callback. When a checkpoint is due, the training thread only copies the
+            // Weights and Biases into the snapshot buffer; the checkpoint thread swaps the snapshot buffer with
+            // its own buffer, writes the model file (see Model.saveModel()) and fsyncs it while training continues.
+            // If a new checkpoint is due before the previous one is written, the newer snapshot replaces the waiting one.
+            //
+            // Full checkpoints are written into a temporary file which atomically replaces checkpointPath.
+            // Incremental checkpoints rewrite only the blocks of parameters changed since the last written checkpoint,
+            // in place in checkpointPath (less I/O, but an interrupted write leaves a mix of two checkpoints).
+            // Do not load checkpointPath into another model while it is being written.
+            class Checkpointer final : public Callbacks::CallbackFunctor
+            {
+                public:
+
+                    uint32_t everyEpochs;                   // checkpoint every N epochs, 0 -> disabled
+                    std::chrono::seconds everySeconds;      // checkpoint every N seconds, 0 -> disabled
+                                                            // checked after each optimizer step, with Hogwild training only at the end of each epoch
+                                                            // (onBatchEnd() is not called with Hogwild training)
+                    bool incremental;                       // rewrite only changed blocks of an existing checkpoint
+                    uint32_t blockSize;                     // number of parameters in one incremental block
+
+                    // Bind checkpointer to the Model, checkpoints are written into checkpointPath
+                    Checkpointer(const Model& model, const std::string checkpointPath, const uint32_t everyEpochs = 1U, 
+                                 const std::chrono::seconds everySeconds = std::chrono::seconds(0), const bool incremental = false, 
+                                 const uint32_t blockSize = 4096U);
+
+                    // Write the waiting checkpoint and stop the checkpoint thread
+                    ~Checkpointer();
+
+                    // Delete default constructor
+                    Checkpointer() = delete;
+
+                    // Delete copy constructor
+                    Checkpointer(Checkpointer& c) = delete;
+
+                    // Delete copy assignment operator
+                    Checkpointer& operator=(const Checkpointer& c) = delete;
+
+                    std::string name() const override
+                    {
+                        return "Checkpointer";
+                    }
+
+                    void onBatchEnd(const Callbacks::TrainingState& state) override;
+                    void onEpochEnd(const Callbacks::TrainingState& state) override;
+
+                    // final checkpoint, waits until it is written
+                    void onTrainEnd(const Callbacks::TrainingState& state) override;
+
+                    // Wait until the waiting checkpoint is written
+                    void flush();
+
+                    // Getters
+                    uint64_t get_mWrittenNo() const;        // number of successfully written checkpoints
+                    uint64_t get_mFailedNo() const;         // number of checkpoints which could not be written
+                    std::string get_mLastError() const;     // error of the last failed checkpoint, empty if no checkpoint failed
+                    uint64_t get_mReplacedNo() const;       // number of snapshots replaced by a newer one before being written
+                    uint64_t get_mWrittenBlocksNo() const;  // number of parameter blocks written by incremental checkpoints
+
+                private:
+
+                    const Model& mModel;
+                    const std::string mCheckpointPath;
+
+                    // double buffer, training thread fills mSnapshot, checkpoint thread writes mWriting
+                    Vector mSnapshot;
+                    Vector mWriting;
+
+                    // parameters of the last written checkpoint, used by incremental checkpoints
+                    Vector mWritten;
+                    bool mHasWritten;
+
+                    std::chrono::steady_clock::time_point mLastCheckpoint;
+
+                    mutable std::mutex mMutex;
+                    std::condition_variable mCv;
+                    bool mSnapshotReady;
+                    bool mWritingActive;
+                    bool mStop;
+
+                    uint64_t mWrittenNo;
+                    uint64_t mFailedNo;
+                    std::string mLastError;
+                    uint64_t mReplacedNo;
+                    uint64_t mWrittenBlocksNo;
+
+                    std::thread mCheckpointThread;
+
+                    // Copy current Model parameters into the snapshot buffer and wake up the checkpoint thread
+                    void takeSnapshot();
+
+                    // Checkpoint thread loop
+                    void checkpointLoop();
+
+                    // Write whole model file into a temporary file and replace the checkpoint with it
+                    void writeFull();
+
+                    // Rewrite changed blocks of parameters in the existing checkpoint
+                    void writeIncremental();
+            };
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef INFERENCE_CONTEXT_CORE_HPP
+#define INFERENCE_CONTEXT_CORE_HPP
+
+#include <memory>
+#include "../Eigen/Dense"
+#include "Model.hpp"
+#include "Workspace.hpp"
+#include "../Common/Common.hpp"
+
+namespace NNFramework
+{
+    namespace Model
+    {
+        namespace InferenceContext
+        {
+            // InferenceContext runs predictions of a trained Model on behalf of a single thread.
+            // The Model is shared read-only between any number of contexts, each context owns only
+            // the activation scratch space (Workspace) needed for the forward pass.
+            // Create one InferenceContext per thread to predict on the same Model concurrently.
+            class InferenceContext final
+            {
+                public:
+
+                    // Bind the context to a compiled Model
+                    // tileRows -> maximal number of data rows propagated trough the Model at once
+                    InferenceContext(std::shared_ptr<const Model> model, const uint32_t tileRows = PREDICT_TILE_ROWS);
+
+                    // Delete default constructor
+                    InferenceContext() = delete;
+
+                    // Delete copy constructor
+                    InferenceContext(InferenceContext& c) = delete;
+
+                    // Delete copy assignment operator
+                    InferenceContext& operator=(const InferenceContext& c) = delete;
+
+                    // Default move constructor
+                    InferenceContext(InferenceContext&& c) = default;
+
+                    // Trained model predict on provided input data
+                    // Same data format as Model::modelPredict(), predictions are written into the provided predictedData
+                    // predictedData has to have one row for each row of inputData and one column for each output of the NN
+                    // no memory is allocated during prediction
+                    void predictInto(const Eigen::Ref<const Matrix>& inputData, Eigen::Ref<Matrix> predictedData);
+
+                    // Getters
+                    const std::shared_ptr<const Model>& get_mModelPtr() const noexcept { return this->mModelPtr; }
+
+                private:
+
+                    std::shared_ptr<const Model> mModelPtr; // Shared trained Model
+                    std::unique_ptr<Workspace::Workspace> mWorkspacePtr; // Forward pass scratch space owned by this context
+            };
+        }
+    }
+}
+
+#endif
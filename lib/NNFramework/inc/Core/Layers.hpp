@@ -4,6 +4,7 @@
 #include <memory>
 #include "../Eigen/Dense"
 #include "Activations.hpp"
+#include "../Common/Common.hpp"
 
 namespace NNFramework
 {
@@ -40,25 +41,35 @@ namespace NNFramework
                 uint8_t get_mLayerId() const noexcept { return this->mLayerId; }
                 uint32_t get_mLearnableCoeffs() const noexcept { return this->mLearnableCoeffs; }
 
-                std::shared_ptr<Eigen::MatrixXd> get_mLayerWeights() const noexcept { return this->mLayerWeights; }
-                std::shared_ptr<Eigen::MatrixXd> get_mLayerZ() const noexcept { return this->mLayerZ; }
-                std::shared_ptr<Eigen::MatrixXd> get_mLayerBias() const noexcept { return this->mLayerBias; }
-                std::shared_ptr<Eigen::MatrixXd> get_mLayerWGradients() const noexcept { return this->mLayerWGradients; }
-                std::shared_ptr<Eigen::MatrixXd> get_mLayerZActivated() const noexcept { return this->mLayerZActivated; }
-                std::shared_ptr<Eigen::MatrixXd> get_mLayerBGradients() const noexcept { return this->mLayerBGradients; }
+                Eigen::Map<Matrix>& get_mLayerWeights() noexcept { return this->mLayerWeights; }
+                Eigen::Map<Matrix>& get_mLayerBias() noexcept { return this->mLayerBias; }
+                Eigen::Map<Matrix>& get_mLayerWGradients() noexcept { return this->mLayerWGradients; }
+                Eigen::Map<Matrix>& get_mLayerBGradients() noexcept { return this->mLayerBGradients; }
+
+                const Eigen::Map<Matrix>& get_mLayerWeights() const noexcept { return this->mLayerWeights; }
+                const Eigen::Map<Matrix>& get_mLayerBias() const noexcept { return this->mLayerBias; }
+                const Eigen::Map<Matrix>& get_mLayerWGradients() const noexcept { return this->mLayerWGradients; }
+                const Eigen::Map<Matrix>& get_mLayerBGradients() const noexcept { return this->mLayerBGradients; }
 
                 // Setters
                 void set_mLayerId(const uint8_t id) { this->mLayerId = id; }
                 void set_mLearnableCoeffs(const uint32_t coeffsNo) { this->mLearnableCoeffs = coeffsNo; }
 
+                // Bind layer Weights and Bias to the Model parameters buffer
+                // Weights matrix (rows x cols) is followed by the Bias vector (rows x 1) starting from parameters
+                void set_mParameters(Scalar* parameters, const Eigen::Index rows, const Eigen::Index cols);
+
+                // Bind layer Weights and Bias gradients to the Model gradients buffer
+                // uses the same layout as set_mParameters()
+                void set_mGradients(Scalar* gradients, const Eigen::Index rows, const Eigen::Index cols);
+
             protected:
-                std::shared_ptr<Eigen::MatrixXd> mLayerWeights;
-                std::shared_ptr<Eigen::MatrixXd> mLayerZ;
-                std::shared_ptr<Eigen::MatrixXd> mLayerBias;
-                
-                std::shared_ptr<Eigen::MatrixXd> mLayerZActivated;
-                std::shared_ptr<Eigen::MatrixXd> mLayerWGradients;
-                std::shared_ptr<Eigen::MatrixXd> mLayerBGradients;
+                // Weights, Bias and their gradients are views into the contiguous parameter and gradient buffers
+                // owned by the Model, they are bound at Model.compileModel() time
+                Eigen::Map<Matrix> mLayerWeights;
+                Eigen::Map<Matrix> mLayerBias;
+                Eigen::Map<Matrix> mLayerWGradients;
+                Eigen::Map<Matrix> mLayerBGradients;
 
                 uint8_t mLayerId;
                 uint8_t mPerceptronNo;
@@ -84,6 +95,12 @@ namespace NNFramework
                     mActivationPtr = std::make_unique<T>();
                 }
 
+                // Dense layer with already constructed activation functor
+                Dense(const uint8_t perceptronNo, std::unique_ptr<Activations::ActivationFunctor> activation) : Dense(perceptronNo)
+                {
+                    mActivationPtr = std::move(activation);
+                }
+
                 Dense(Dense&& l) : Layer(std::move(l)) { /* Nothing to do, just call parent move constructor */ };
 
                 // Delete copy assignment operator
@@ -3,6 +3,7 @@
 
 #include <string>
 #include "../Eigen/Dense"
+#include "../Common/Common.hpp"
 #include <math.h>
 
 namespace NNFramework
@@ -17,20 +18,28 @@ namespace NNFramework
             
             // param: x -> expected
             // param: y -> predicted
-            Eigen::MatrixXd operator()(const Eigen::MatrixXd& x, const Eigen::MatrixXd& y, const bool derive = false) const
+            Matrix operator()(const Eigen::Ref<const Matrix>& x, const Eigen::Ref<const Matrix>& y, const bool derive = false) const
             {
+                Matrix result(x.rows(), x.cols());
+
                 if(derive)
                 {
-                    return derivative(x, y);
+                    derivative(x, y, result);
                 }
                 else
                 {
-                    return loss(x, y);
+                    loss(x, y, result);
                 }
+
+                return result;
             }
             
-            virtual Eigen::MatrixXd loss(const Eigen::MatrixXd& x, const Eigen::MatrixXd& y) const = 0;
-            virtual Eigen::MatrixXd derivative(const Eigen::MatrixXd& x, const Eigen::MatrixXd& y) const = 0;
+            // param: x -> expected
+            // param: y -> predicted
+            // param: result -> output, has to be of the same size as x and y
+            // results are written directly into result, no memory is allocated
+            virtual void loss(const Eigen::Ref<const Matrix>& x, const Eigen::Ref<const Matrix>& y, Eigen::Ref<Matrix> result) const = 0;
+            virtual void derivative(const Eigen::Ref<const Matrix>& x, const Eigen::Ref<const Matrix>& y, Eigen::Ref<Matrix> result) const = 0;
         };
 
         struct MeanSquaredError final : LossFunctor
@@ -42,19 +51,14 @@ namespace NNFramework
 
             // param: x -> expected
             // param: y -> predicted  
-            Eigen::MatrixXd loss(const Eigen::MatrixXd& x, const Eigen::MatrixXd& y) const
+            void loss(const Eigen::Ref<const Matrix>& x, const Eigen::Ref<const Matrix>& y, Eigen::Ref<Matrix> result) const override
             {
-                Eigen::MatrixXd diffSquared = x - y;
-                diffSquared = diffSquared.cwiseProduct(diffSquared);
-
-                return diffSquared;
+                result = (x - y).array().square().matrix();
             }
 
-            Eigen::MatrixXd derivative(const Eigen::MatrixXd& x, const Eigen::MatrixXd& y) const
+            void derivative(const Eigen::Ref<const Matrix>& x, const Eigen::Ref<const Matrix>& y, Eigen::Ref<Matrix> result) const override
             {
-                Eigen::MatrixXd diff = y - x;
-
-                return diff;
+                result = y - x;
             }
         };
 
@@ -67,28 +71,21 @@ namespace NNFramework
 
             // param: x -> expected
             // param: y -> predicted
-            Eigen::MatrixXd loss(const Eigen::MatrixXd& x, const Eigen::MatrixXd& y) const
+            void loss(const Eigen::Ref<const Matrix>& x, const Eigen::Ref<const Matrix>& y, Eigen::Ref<Matrix> result) const override
             {
-                Eigen::MatrixXd diffAbs = x - y;
-                diffAbs = diffAbs.cwiseAbs();
-
-                return diffAbs;
+                result = (x - y).cwiseAbs();
             }
 
             // derivative of MeanAbsoluteError is not defined in 0
-            Eigen::MatrixXd derivative(const Eigen::MatrixXd& x, const Eigen::MatrixXd& y) const
+            void derivative(const Eigen::Ref<const Matrix>& x, const Eigen::Ref<const Matrix>& y, Eigen::Ref<Matrix> result) const override
             {
-                Eigen::MatrixXd result(x.rows(), x.cols());
-
                 for(uint32_t i = 0; i < result.rows(); ++i)
                 {
                     for(uint32_t j = 0; j < result.cols(); ++j)
                     {
-                        result(i, j) = (y(i, j) > x(i, j) ? 1.0 : (y(i, j) < x(i, j) ? -1.0 : NAN));
+                        result(i, j) = (y(i, j) > x(i, j) ? static_cast<Scalar>(1.0) : (y(i, j) < x(i, j) ? static_cast<Scalar>(-1.0) : static_cast<Scalar>(NAN)));
                     }
                 }
-
-                return result;
             }     
         };
 
@@ -102,30 +99,14 @@ namespace NNFramework
             // param: x -> expected
             // param: y -> predicted
             // BCELoss =  −(x * log(y) + (1−x) * log(1−y))
-            Eigen::MatrixXd loss(const Eigen::MatrixXd& x, const Eigen::MatrixXd& y) const
+            void loss(const Eigen::Ref<const Matrix>& x, const Eigen::Ref<const Matrix>& y, Eigen::Ref<Matrix> result) const override
             {
-                Eigen::MatrixXd predLogFirst = y.array().log10().matrix();
-                Eigen::MatrixXd predLogSecond = ((Eigen::MatrixXd::Ones(y.rows(), y.cols()) - y).array().log10()).matrix();
-                Eigen::MatrixXd expectedDiff = (Eigen::MatrixXd::Ones(x.rows(), x.cols()) - x);
-
-                Eigen::MatrixXd retLoss = -1 * (x.cwiseProduct(predLogFirst) + expectedDiff.cwiseProduct(predLogSecond));
-
-                return retLoss;
+                result = -(x.array() * y.array().log10() + (static_cast<Scalar>(1.0) - x.array()) * (static_cast<Scalar>(1.0) - y.array()).log10()).matrix();
             }
-            Eigen::MatrixXd derivative(const Eigen::MatrixXd& x, const Eigen::MatrixXd& y) const
-            {
-                Eigen::MatrixXd result(x.rows(), x.cols());
 
-                for(uint32_t i = 0; i < result.rows(); ++i)
-                {
-                    for(uint32_t j = 0; j < result.cols(); ++j)
-                    {
-                        // change to eigen matrix operation
-                        result(i, j) = (y(i, j) - x(i, j)) / (y(i, j) * (1 - y(i, j)));
-                    }
-                }
-
-                return result;
+            void derivative(const Eigen::Ref<const Matrix>& x, const Eigen::Ref<const Matrix>& y, Eigen::Ref<Matrix> result) const override
+            {
+                result = ((y - x).array() / (y.array() * (static_cast<Scalar>(1.0) - y.array()))).matrix();
             }  
         };
     }
@@ -3,6 +3,7 @@
 
 #include <string>
 #include "../Eigen/Dense"
+#include "../Common/Common.hpp"
 
 namespace NNFramework
 {
@@ -13,15 +14,19 @@ namespace NNFramework
         struct MetricsFunctor
         {
             virtual std::string name() const = 0;
-            virtual double operator()(const Eigen::VectorXd& x, const Eigen::VectorXd& y) const = 0;
+
+            // param: x -> expected
+            // param: y -> predicted
+            // metrics is calculated over all elements of x and y, no memory is allocated
+            virtual Scalar operator()(const Eigen::Ref<const Matrix>& x, const Eigen::Ref<const Matrix>& y) const = 0;
         };
 
         struct ClassificationAccuracy final : MetricsFunctor
         {
-                double threshold = 0.1;
+                Scalar threshold = 0.1;
 
                 ClassificationAccuracy() = default;
-                ClassificationAccuracy(const double thr) : threshold(thr) {}
+                ClassificationAccuracy(const Scalar thr) : threshold(thr) {}
 
                 std::string name() const override
                 {
@@ -31,15 +36,11 @@ namespace NNFramework
                 // param: x -> expected
                 // param: y -> predicted
                 // acc = correct / noofpred
-                double operator()(const Eigen::VectorXd& x, const Eigen::VectorXd& y) const override
+                Scalar operator()(const Eigen::Ref<const Matrix>& x, const Eigen::Ref<const Matrix>& y) const override
                 {
-                    Eigen::VectorXd diffBool = x - y;
-                    diffBool = diffBool.cwiseAbs();
-                    diffBool = diffBool.unaryExpr([this](double x){ return (x <= threshold) ? 1.0 : 0.0; });
+                    Scalar correct = static_cast<Scalar>(((x - y).array().abs() <= threshold).count());
 
-                    double correct = diffBool.sum();
-
-                    return correct / diffBool.size();
+                    return correct / x.size();
                 }
         };
 
@@ -52,12 +53,9 @@ namespace NNFramework
 
             // param: x -> expected
             // param: y -> predicted
-            double operator()(const Eigen::VectorXd& x, const Eigen::VectorXd& y) const override
+            Scalar operator()(const Eigen::Ref<const Matrix>& x, const Eigen::Ref<const Matrix>& y) const override
             {
-                Eigen::VectorXd diffSquared = x - y;
-                diffSquared = diffSquared.cwiseProduct(diffSquared);
-                
-                return (diffSquared.sum() / diffSquared.size());
+                return ((x - y).squaredNorm() / x.size());
             }      
         };
 
@@ -70,12 +68,9 @@ namespace NNFramework
 
             // param: x -> expected
             // param: y -> predicted
-            double operator()(const Eigen::VectorXd& x, const Eigen::VectorXd& y) const override
+            Scalar operator()(const Eigen::Ref<const Matrix>& x, const Eigen::Ref<const Matrix>& y) const override
             {
-                Eigen::VectorXd diffAbs = x - y;
-                diffAbs = diffAbs.cwiseAbs();
-
-                return (diffAbs.sum() / diffAbs.size());
+                return ((x - y).cwiseAbs().sum() / x.size());
             }      
         };
 
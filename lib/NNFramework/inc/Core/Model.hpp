@@ -4,12 +4,24 @@
 #include <memory>
 #include <vector>
 #include <tuple>
+#include <barrier>
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <exception>
 #include "../Eigen/Dense"
 #include "Layers.hpp"
 #include "Activations.hpp"
 #include "ModelConfiguration.hpp"
 #include "WeightInitializer.hpp"
+#include "Workspace.hpp"
+#include "ModelFile.hpp"
+#include "../Utilities/MappedFile.hpp"
+#include "../Utilities/Dataset.hpp"
+#include "../Utilities/DataSource.hpp"
 #include "../Utilities/DataHandler.hpp"
+#include "../Utilities/Scaler.hpp"
 #include "../Common/Common.hpp"
 
 namespace NNFramework
@@ -20,7 +32,7 @@ namespace NNFramework
         {
             public:
 
-                Model() : mLearnableCoeffs(0), mLayersNo(0), mIsCompiled(false) { }
+                Model() : mParameters(nullptr, 0), mLearnableCoeffs(0), mLayersNo(0), mIsCompiled(false), mIsLoaded(false) { }
 
                 // Add new layer to the NN Model
                 // check what happens when sent by reference
@@ -29,15 +41,26 @@ namespace NNFramework
                 // Compile model with added layers, optimizer, loss function and metrics 
                 bool compileModel(ModelConfiguration::ModelConfiguration& modelConfig);
 
-                // Save model weights to desired location
-                bool saveModel(std::string modelPath = "./model.csv") const;
+                // Save model topology, activations and weights to desired location
+                // binary format described in ModelFile.hpp
+                bool saveModel(std::string modelPath = "./model.nnfw") const;
 
-                // Load model weights from desired location
-                bool loadModel();
+                // Save model topology and activations with the provided Weights and Biases
+                // parameters -> same layout as get_mParameters(), e.g. a snapshot taken during training
+                bool saveModel(std::string modelPath, const Eigen::Ref<const Vector>& parameters) const;
+
+                // Load model topology, activations and weights from desired location
+                // the file is memory mapped and weights are used in place, without parsing or copying
+                // (copy-on-write mapping -> processes loading the same file share one physical copy of the weights,
+                // training a loaded model modifies only the private copies of the written pages, never the file)
+                // empty model -> layers are created from the file, compileModel() keeps the loaded weights
+                // loaded model can be saved or its input scaler folded (foldInputScaler()) before it is compiled
+                // model with layers -> layers have to match the file, weights are replaced
+                bool loadModel(std::string modelPath = "./model.nnfw");
                 
                 // Train desired model
                 // Expected inputData format:
-                // Eigen::MatrixXd
+                // NNFramework::Matrix
                 // Data:
                 // 1)   [x11, x12, ..., x1m]
                 // 2)   [x21, x22, ..., x2m]
@@ -45,18 +68,30 @@ namespace NNFramework
                 // n)   [xn1, xn2, ..., xnm]
                 // 
                 // Expected expectedData format:
-                // Eigen::MatrixXd
+                // NNFramework::Matrix
                 // Data:
                 // 1)   [y11, y12, ..., y1m]
                 // 2)   [y21, y22, ..., y2m]
                 // ...
                 // n)   [yn1, yn2, ..., ynm]
                 //         
-                void modelFit(const Eigen::MatrixXd& inData, const Eigen::MatrixXd& expData, const uint16_t epochs);
+                void modelFit(const Matrix& inData, const Matrix& expData, const uint16_t epochs);
+
+                // Train desired model on the selected columns of the binary columnar dataset
+                // inColumns -> names of the input data columns, in the order of the input layer perceptrons
+                // expColumns -> names of the expected data columns, in the order of the output layer perceptrons
+                // only the selected columns are read from the memory mapped dataset shards, block by block (see DatasetDataSource)
+                void modelFit(const Dataset::Dataset& dataset, const std::vector<std::string>& inColumns, const std::vector<std::string>& expColumns, const uint16_t epochs);
+
+                // Train desired model on the data rows taken from the data source
+                // data source provides data rows in batches (see DataSource.hpp), thus the data does not have to fit into memory
+                // data source input and expected data columns have to match the input and output layer
+                // exception thrown by the data source or a callback stops all training threads and is rethrown on the calling thread
+                void modelFit(DataSource::DataSource& dataSource, const uint16_t epochs);
 
                 // Trained model predict on provided input data
                 // Expected inputData format:
-                // Eigen::MatrixXd
+                // NNFramework::Matrix
                 // Data:
                 // 1)   [x11, x12, ..., x1m]
                 // 2)   [x21, x22, ..., x2m]
@@ -64,71 +99,250 @@ namespace NNFramework
                 // n)   [xn1, xn2, ..., xnm]
                 // 
                 // Return value data format:
-                // Eigen::MatrixXd
+                // NNFramework::Matrix
                 // Data:
                 // 1)   [y11, y12, ..., y1m]
                 // 2)   [y21, y22, ..., y2m]
                 // ...
                 // n)   [yn1, yn2, ..., ynm]
                 //
-                Eigen::MatrixXd modelPredict(Eigen::MatrixXd& inputData);
+                Matrix modelPredict(const Eigen::Ref<const Matrix>& inputData);
+
+                // Trained model predict on provided input data
+                // Same as modelPredict() above, predictions are written into the provided predictedData
+                // predictedData has to have one row for each row of inputData and one column for each output of the NN
+                // no memory is allocated during prediction
+                void modelPredict(const Eigen::Ref<const Matrix>& inputData, Eigen::Ref<Matrix> predictedData);
+
+                // Trained model predict on provided input data
+                // Same as modelPredict() above, intermediate results are stored in the provided Workspace instead of the Model one
+                // Model is not modified, thus concurrent calls with different Workspaces are allowed (see InferenceContext)
+                // forward pass only Workspace is sufficient, its capacity limits the number of data rows propagated at once
+                void modelPredict(Workspace::Workspace& workspace, const Eigen::Ref<const Matrix>& inputData, Eigen::Ref<Matrix> predictedData) const;
+
+                // Fold the input scaler into the Weights and Bias of the first hidden layer
+                // scaling of the input layer values is affine per input, (x - offset) * scale, thus the first layer
+                // W * ((x - offset) * scale) + b == (W * diag(scale)) * x + (b - W * diag(scale) * offset)
+                // afterwards the model predicts on the raw (unscaled) input data, e.g. before saveModel() for serving
+                // inScaler -> scaler fitted to the input data the model was trained on, one column per input layer perceptron
+                void foldInputScaler(const Scaler::Scaler& inScaler);
 
                 // Show model summary by printing it on std::cout
                 void modelSummary() const;
 
+                // Show training profile of the last modelFit() by printing it on std::cout
+                // time spent in each training phase and throughput, phases are measured only if mProfiling is enabled
+                void modelProfileSummary() const;
+
                 // Getters
                 uint32_t get_mLearnableCoeffs() const noexcept { return this->mLearnableCoeffs; }
                 uint16_t get_mLayersNo() const noexcept { return this->mLayersNo; }
+                const std::vector<std::unique_ptr<Layers::Layer>>& get_mLayers() const noexcept { return this->mLayers; }
                 bool get_mIsCompiled() const noexcept { return this->mIsCompiled; }
 
+                // Weights and Biases of all layers in one contiguous buffer
+                // layer after layer (input layer excluded), Weights matrix (column major) followed by the Bias vector
+                const Eigen::Map<Vector>& get_mParameters() const noexcept { return this->mParameters; }
+
+                // Gradients of all layers of the last training step, same layout as get_mParameters()
+                const Vector& get_mGradients() const noexcept { return this->mWorkspaces[0]->mGradients; }
+
                 // get ModelHistory
                 auto get_mModelHistory() const noexcept { return this->mHistory; }
 
             private:
                 // saves model training history
                 // Loss, Validation Loss, Accuracy and Validation Accuracy
+                // wall time of each epoch and its training phases in seconds, phases are measured by the first training thread
                 struct ModelHistory final
                 {
-                    Eigen::VectorXd hLoss;
-                    Eigen::VectorXd hAccuracy;
+                    Vector hLoss;
+                    Vector hAccuracy;
+
+                    Vector hShuffleTime;
+                    Vector hDataTime;
+                    Vector hForwardTime;
+                    Vector hLossTime;
+                    Vector hBackpropTime;
+                    Vector hReduceTime;
+                    Vector hOptimizerTime;
+                    Vector hEpochTime;
+                    Vector hSamplesPerSec;
+                };
+
+                // Training phases measured by the PhaseTimer
+                enum TrainingPhase : uint8_t
+                {
+                    SHUFFLE_PHASE = 0U,
+                    DATA_PHASE,
+                    FORWARD_PHASE,
+                    LOSS_PHASE,
+                    BACKPROP_PHASE,
+                    REDUCE_PHASE,
+                    OPTIMIZER_PHASE,
+                    TRAINING_PHASES_NO
+                };
+
+                // Wall time measurement of the training phases of one epoch
+                // when disabled each call is a single branch, clock is never read
+                struct PhaseTimer final
+                {
+                    bool enabled = false;
+                    std::chrono::steady_clock::time_point start;
+                    std::array<double, TRAINING_PHASES_NO> times {};
+
+                    // Start measurement of the next phase
+                    void begin()
+                    {
+                        if(true == enabled)
+                        {
+                            start = std::chrono::steady_clock::now();
+                        }
+                    }
+
+                    // Add time elapsed since begin() or the previous end() to the phase, next phase starts immediately
+                    void end(const TrainingPhase phase)
+                    {
+                        if(true == enabled)
+                        {
+                            const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                            times[phase] += std::chrono::duration<double>(now - start).count();
+                            start = now;
+                        }
+                    }
+                };
+
+                // Training data shared by all training threads during modelFit()
+                struct TrainingData final
+                {
+                    DataSource::DataSource& source;
+                    std::mutex sourceMutex;                 // Hogwild threads take their batches from the data source one at a time
+                    std::atomic<uint32_t> batchRows {0U};   // data rows of the current batch (synchronous training)
+                    std::atomic<uint32_t> epochRows {0U};   // data rows taken from the data source in the current epoch
+                    std::atomic<bool> aborted {false};      // training is aborted by the exception of one of the threads
+                    std::mutex errorMutex;
+                    std::exception_ptr error = nullptr;     // first exception thrown by the training threads, rethrown by modelFit()
+
+                    explicit TrainingData(DataSource::DataSource& source) : source(source) { }
                 };
 
                 ModelHistory mHistory; // Model history container
 
                 std::unique_ptr<ModelConfiguration::ModelConfiguration> mModelConfigPtr; // Model configuration container
                 std::unique_ptr<WeightInitializer::WeightInitializer> mWeightInitializerPtr; // Layer weights initializer based on the activation function of the layer
+                std::vector<std::unique_ptr<Workspace::Workspace>> mWorkspaces; // Preallocated intermediate results of forward pass and backpropagation, one per training thread
 
                 std::vector<std::unique_ptr<Layers::Layer>> mLayers; // Number of Layers is not known in advance thus, std::vector is more suitable for storing Layers
+
+                // Contiguous (aligned) buffer holding Weights and Biases of all layers
+                // each layer holds Eigen::Map views into this buffer
+                // gradients of each training thread are stored in its Workspace with the same layout
+                // the buffer is either owned by the Model or it is a memory mapped model file (see loadModel())
+                Vector mParametersStorage;
+                std::unique_ptr<MappedFile::MappedFile> mMappedFilePtr;
+                Eigen::Map<Vector> mParameters;
+                std::vector<Eigen::Index> mLayerOffsets; // offset of each layer in the parameters buffer
                 uint32_t mLearnableCoeffs;
                 uint16_t mLayersNo;
                 bool mIsCompiled;
+                bool mIsLoaded; // parameters are restored by loadModel()
 
                 // Check if model is compiled
                 void checkIsModelCompiled(std::string fName) const;
 
-                // Check if data matrix (Eigen::MatrixXd) is empty
+                // Check if data matrix (Matrix) is empty
                 // throws an exception if data matrix is empty
-                void isDataEmpty(const std::string fName, const Eigen::MatrixXd& data) const;
+                void isDataEmpty(const std::string fName, const Eigen::Ref<const Matrix>& data) const;
 
                 // Check if input data and expected data have the same amount of rows
                 // Check if there is a pair for each input data tensor in expected data and vice versa
-                void checkInExpRowDim(const std::string fName, const Eigen::MatrixXd& inData, const Eigen::MatrixXd& expData) const;
+                void checkInExpRowDim(const std::string fName, const Eigen::Ref<const Matrix>& inData, const Eigen::Ref<const Matrix>& expData) const;
 
-                // Check if the input Matrix has the same amount of columns as the number of rows in layer data
-                void checkRowColDim(const std::string fName, const Eigen::MatrixXd& inData, const Eigen::MatrixXd& layerData) const;
+                // Check if the input Matrix has the same amount of columns as the number of perceptrons in layer
+                void checkRowColDim(const std::string fName, const Eigen::Ref<const Matrix>& inData, const uint32_t perceptronNo) const;
 
                 // Initialize all layers coefficients
+                // parameters restored by loadModel() are kept as they are
                 void initializeLayers();
 
+                // Number of Weights and Biases of all layers
+                Eigen::Index getParametersNo() const;
+
+                // Bind Weights and Bias of each layer to its part of the parameters buffer
+                void bindLayers();
+
+                // Check if the data rows of the data source have one value for each perceptron of the input and output layer
+                void checkDataSourceDim(const std::string fName, const DataSource::DataSource& dataSource) const;
+
+                // Check if configured batch size is greater than zero
+                void checkBatchSize(const std::string fName) const;
+
+                // Check if configured number of threads is greater than zero
+                void checkThreadsNo(const std::string fName) const;
+
+                // Allocate Workspaces of all training threads
+                void initializeWorkspaces();
+
+                // Training loop of one thread
+                // first thread takes each batch from the data source, each thread propagates its share of the batch trough its own Workspace
+                // threads meet at syncPoint to reduce the gradients before the first thread runs the optimizer
+                void fitThread(const uint16_t threadIdx, std::barrier<>& syncPoint, TrainingData& trainingData, const uint16_t epochs);
+
+                // Asynchronous (Hogwild) training loop of one thread
+                // each thread takes the next batch of data rows from the data source and runs the optimizer on the shared
+                // Weights and Biases with its own gradients, without locking; threads meet at syncPoint only between epochs
+                void fitHogwildThread(const uint16_t threadIdx, std::barrier<>& syncPoint, TrainingData& trainingData, const uint16_t epochs);
+
+                // Wait for all training threads at the synchronization point
+                // Return value: false if the training is aborted, the thread has left the synchronization point and has to return
+                bool synchronizeThreads(std::barrier<>& syncPoint, const TrainingData& trainingData) const;
+
+                // Abort the training of all threads because of the exception thrown by this thread
+                // exception is stored for modelFit() and the thread leaves the synchronization point, thus no thread waits for it
+                void abortTraining(std::barrier<>& syncPoint, TrainingData& trainingData, const std::exception_ptr error) const;
+
+                // Check if training data rows are shuffled at the beginning of the epoch
+                bool isShuffleEpoch(const uint32_t ep) const;
+
+                // Save loss, metrics and profile of the epoch into the ModelHistory
+                void saveEpochResults(const uint32_t ep, const double epochTime, const uint32_t rowsNo, const PhaseTimer& timer);
+
+                // Sum loss and metrics accumulated in the current epoch by all threads
+                // Return values: tuple[0] = loss, tuple[1] = metrics
+                std::tuple<Scalar, double> reduceLossAndMetrics() const;
+
+                // Training state of the current epoch based on the loss and metrics accumulated by all threads
+                Callbacks::TrainingState getTrainingState(const uint32_t ep, const uint32_t epochs, const uint32_t batch, const uint32_t rowsDone, const uint32_t rowsNo) const;
+
+                // Index of the batch holding the last of the data rows taken in the epoch, 0 if the epoch did not yield any data row
+                uint32_t getLastBatchIdx(const uint32_t rowsNo) const;
+
+                // Notify training observers about the end of the epoch, epoch results are taken from the ModelHistory
+                void notifyEpochEnd(const uint32_t ep, const uint32_t epochs, const uint32_t rowsNo) const;
+
+                // Save epoch time, throughput and phase times of the epoch into the ModelHistory
+                void saveEpochProfile(const uint32_t ep, const double epochTime, const uint32_t rowsNo, const PhaseTimer& timer);
+
                 // Forward pass
-                void forwardPass(const Eigen::MatrixXd& inputData, const uint32_t rowIdx);
+                // propagates batchSize columns of the Workspace input layer trough the NNetwork at once
+                // each data row is stored as one column of the layer Z and Z activated matrices
+                // cacheDerivatives -> dA/dZ of each layer is calculated together with the activation for the following backPropagation()
+                void forwardPass(Workspace::Workspace& workspace, const uint32_t batchSize, const bool cacheDerivatives) const;
 
                 // Back propagation
-                void backPropagation(const Eigen::MatrixXd& expData);
+                // Workspace expected output holds one expected data row for each column propagated in the last forwardPass()
+                // the last forwardPass() has to cache the activation derivatives
+                // calculated gradients are summed over the batch, scaled by batchScale and written into the Workspace gradients
+                void backPropagation(Workspace::Workspace& workspace, const uint32_t batchSize, const Scalar batchScale) const;
 
-                // Calculate loss
-                // Return values: tuple[0] = loss, tuple[1] = metrics
-                std::tuple<Eigen::MatrixXd, double> calculateLossAndMetrics(const Eigen::MatrixXd& expectedData, const uint32_t rowIdx);
+                // Views of the layer Weights and Bias gradients inside of the Workspace gradients buffer
+                Eigen::Map<Matrix> layerWGradientsView(Workspace::Workspace& workspace, const uint32_t layerIdx) const;
+                Eigen::Map<Matrix> layerBGradientsView(Workspace::Workspace& workspace, const uint32_t layerIdx) const;
+
+                // Calculate loss and metrics of the last forwardPass()
+                // Return value: metrics summed over the batch rows
+                // loss of each output summed over the batch rows is accumulated into loss
+                Scalar calculateLossAndMetrics(Workspace::Workspace& workspace, const uint32_t batchSize, Vector& loss) const;
 
         };
     }
@@ -4,6 +4,9 @@
 #include "Loss.hpp"
 #include "Metrics.hpp"
 #include "Optimizers.hpp"
+#include "Callbacks.hpp"
+#include <memory>
+#include <vector>
 
 namespace NNFramework
 {
@@ -45,6 +48,33 @@ namespace NNFramework
                     // ShuffleData class unique_ptr
                     std::unique_ptr<ShuffleData> mShuffleData;
 
+                    // Number of data rows propagated trough the model before each optimizer step
+                    // mBatchSize = 1 -> stochastic gradient descent (update after every single data row)
+                    uint32_t mBatchSize = 1U;
+
+                    // Number of threads each batch is split across during training (data parallel training)
+                    // each thread propagates its share of the batch, gradients are reduced before a single optimizer step
+                    uint16_t mThreadsNo = 1U;
+
+                    // Asynchronous (Hogwild) training, used only with mThreadsNo > 1
+                    // each thread takes the next mBatchSize data rows and updates the shared Weights and Biases without locking
+                    // no synchronization between training steps, updates of different threads may overlap
+                    bool mHogwild = false;
+
+                    // Measure wall time of each training phase (shuffle, forward pass, loss and metrics, backpropagation,
+                    // gradients reduction and optimizer step) in every epoch, results are saved in the ModelHistory
+                    // disabled -> single branch per phase, no time measurement
+                    bool mProfiling = false;
+
+                    // Number of batches prepared ahead of training by a background producer thread
+                    // data loading and gathering then overlap with the forward and backward passes
+                    // mPrefetchDepth = 0 -> batches are prepared by the training thread on demand
+                    uint32_t mPrefetchDepth = 0U;
+
+                    // Training observers, called in the order of registration
+                    // no callbacks -> no logging nor any other per batch work during training
+                    std::vector<std::shared_ptr<Callbacks::CallbackFunctor>> mCallbacks;
+
                     template<class X, class Y, class Z>
                     ModelConfiguration(Loss::LossType<X>, 
                                        Metrics::MetricsType<Y>, 
@@ -77,7 +107,13 @@ namespace NNFramework
                     ModelConfiguration(ModelConfiguration&& m) : mLossPtr(std::move(m.mLossPtr)), 
                                                                  mMetricsPtr(std::move(m.mMetricsPtr)), 
                                                                  mOptimizerPtr(std::move(m.mOptimizerPtr)),
-                                                                 mShuffleData(std::move(m.mShuffleData))
+                                                                 mShuffleData(std::move(m.mShuffleData)),
+                                                                 mBatchSize(m.mBatchSize),
+                                                                 mThreadsNo(m.mThreadsNo),
+                                                                 mHogwild(m.mHogwild),
+                                                                 mProfiling(m.mProfiling),
+                                                                 mPrefetchDepth(m.mPrefetchDepth),
+                                                                 mCallbacks(std::move(m.mCallbacks))
                     { }
                     
                     // Delete copy assignment operator
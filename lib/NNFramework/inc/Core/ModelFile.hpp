@@ -0,0 +1,57 @@
+#ifndef MODELFILE_CORE_HPP
+#define MODELFILE_CORE_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+namespace NNFramework
+{
+    namespace Model
+    {
+        namespace ModelFile
+        {
+            // Binary model file layout (native byte order):
+            // 
+            // Header                       (32 bytes)
+            // LayerRecord x layersNo       (32 bytes each, input layer first)
+            // padding up to parametersOffset
+            // parameters blob              (parametersNo x scalarSize bytes, same layout as Model.get_mParameters())
+            //
+            // parametersOffset is aligned to PARAMETERS_ALIGNMENT, thus the blob of a memory mapped file
+            // is aligned for vectorized access and can be used in place without copying.
+
+            constexpr char MAGIC[4] = { 'N', 'N', 'F', 'W' };
+            constexpr uint32_t VERSION = 1U;
+            constexpr uint64_t PARAMETERS_ALIGNMENT = 64U;
+            constexpr size_t ACTIVATION_NAME_SIZE = 28U;
+
+            struct Header final
+            {
+                char magic[4];
+                uint32_t version;
+                uint32_t scalarSize;        // sizeof(Scalar) of the NNFramework build that saved the model
+                uint32_t layersNo;
+                uint64_t parametersNo;
+                uint64_t parametersOffset;  // offset of the parameters blob from the beginning of the file
+            };
+
+            struct LayerRecord final
+            {
+                uint32_t perceptronNo;
+                char activation[ACTIVATION_NAME_SIZE];  // zero terminated ActivationFunctor::name()
+            };
+
+            static_assert(sizeof(Header) == 32U, "Unexpected model file header size");
+            static_assert(sizeof(LayerRecord) == 32U, "Unexpected model file layer record size");
+
+            // Offset of the parameters blob for the given number of layers
+            constexpr uint64_t parametersOffset(const uint32_t layersNo)
+            {
+                const uint64_t recordsEnd = sizeof(Header) + (static_cast<uint64_t>(layersNo) * sizeof(LayerRecord));
+                return ((recordsEnd + PARAMETERS_ALIGNMENT - 1U) / PARAMETERS_ALIGNMENT) * PARAMETERS_ALIGNMENT;
+            }
+        }
+    }
+}
+
+#endif
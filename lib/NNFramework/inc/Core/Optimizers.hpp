@@ -2,7 +2,7 @@
 #define OPTIMIZERS_CORE_HPP
 
 #include <memory>
-#include "Layers.hpp"
+#include <string>
 #include "../Eigen/Dense"
 #include "../Common/Common.hpp"
 
@@ -14,10 +14,13 @@ namespace NNFramework
 
         struct OptimizersFunctor
         {
-            double learningRate = 0.5;
+            Scalar learningRate = 0.5;
             
             virtual std::string name() const = 0;
-            virtual void operator()(const std::vector<std::unique_ptr<Layers::Layer>>& layers) const = 0;
+
+            // param: parameters -> contiguous buffer holding Weights and Biases of all Model layers
+            // param: gradients -> contiguous buffer holding gradients of all Model layers, same layout as parameters
+            virtual void operator()(Eigen::Ref<Vector> parameters, const Eigen::Ref<const Vector>& gradients) const = 0;
         };
 
         struct GradientDescent final : OptimizersFunctor
@@ -28,30 +31,12 @@ namespace NNFramework
                 return "GradientDescent";
             }
 
-            void operator()(const std::vector<std::unique_ptr<Layers::Layer>>& layers) const override
+            void operator()(Eigen::Ref<Vector> parameters, const Eigen::Ref<const Vector>& gradients) const override
             {
-                std::shared_ptr<Eigen::MatrixXd> layerWeights;
-                std::shared_ptr<Eigen::MatrixXd> layerWeightsGradients;
-                std::shared_ptr<Eigen::MatrixXd> layerBias;
-                std::shared_ptr<Eigen::MatrixXd> layerBiasGradients;
-
-                // skip first layer as there are no gradients calculated for the pass trough layer
-                for(uint32_t i = (INPUT_LAYER_IDX + 1U); i < layers.size(); ++i)
-                {
-                    layerWeights = layers[i]->get_mLayerWeights();
-                    layerWeightsGradients = layers[i]->get_mLayerWGradients();
-                    layerBias = layers[i]->get_mLayerBias();
-                    layerBiasGradients = layers[i]->get_mLayerBGradients();
-
-                    // w(t+1) = w(t) - lr * dL/dW -> t = epoch
-                    (*layerWeights) = (*layerWeights) - ((*layerWeightsGradients) * learningRate);
-
-                    // b(t+1) = b(t) - lr * dL/dB -> t = epoch
-                    Eigen::MatrixXd biasGradSum = Eigen::MatrixXd::Zero((*layerBiasGradients).rows(), (*layerBiasGradients).cols());
-                    biasGradSum.array() += ((*layerBiasGradients).sum() / (*layerBiasGradients).rows());
-                    
-                    (*layerBias) = (*layerBias) - ((biasGradSum) * learningRate);
-                }
+                // w(t+1) = w(t) - lr * dL/dW -> t = epoch
+                // b(t+1) = b(t) - lr * dL/dB -> t = epoch
+                // single vectorized pass over Weights and Biases of all layers
+                parameters.noalias() -= learningRate * gradients;
             }
         };
     }
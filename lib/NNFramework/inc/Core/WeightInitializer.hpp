@@ -2,8 +2,9 @@
 #define WEIGHTINITIALIZER_CORE_HPP
 
 #include <memory>
-#include <random>
+#include <string>
 #include "../Eigen/Dense"
+#include "../Common/Common.hpp"
 
 namespace NNFramework
 {
@@ -28,17 +29,16 @@ namespace NNFramework
                     WeightInitializer& operator=(WeightInitializer&& wInitializer) = delete;
 
                     // Initialize weights based on the activation function
-                    void initializeWeights(const std::shared_ptr<Eigen::MatrixXd>& weights, std::string activationName);
+                    void initializeWeights(Eigen::Ref<Matrix> weights, std::string activationName);
 
                 private:
-                    // Initialization distributions
-                    std::default_random_engine mGenerator;
-                    std::normal_distribution<double> mNormalDistribution;
-                    std::uniform_real_distribution<double> mUniformDistribution;
+                    // Initialization distributions parameters
+                    Scalar mUniformLimit = 0.0;     // uniform distribution in [-mUniformLimit, mUniformLimit)
+                    Scalar mNormalStdDev = 1.0;     // normal distribution with zero mean
 
-                    // set normal distribution parameters
-                    void set_XavierGlorotParameters(const double& prevPercNo, const double& perceptronNo);
                     // set uniform distribution parameters
+                    void set_XavierGlorotParameters(const double& prevPercNo, const double& perceptronNo);
+                    // set normal distribution parameters
                     void set_KaimingHeParameters(const double& prevPercNo);
             };
         }
@@ -0,0 +1,70 @@
+#ifndef WORKSPACE_CORE_HPP
+#define WORKSPACE_CORE_HPP
+
+#include <memory>
+#include <vector>
+#include "../Eigen/Dense"
+#include "Layers.hpp"
+#include "../Common/Common.hpp"
+
+namespace NNFramework
+{
+    namespace Model
+    {
+        namespace Workspace
+        {
+            // Workspace holds all intermediate results of the forward pass and backpropagation.
+            // Buffers are allocated once for the maximal number of data rows (columns) propagated at once,
+            // forward pass and backpropagation only operate on the first batchSize columns of each buffer.
+            // This way training and prediction do not allocate any memory after the Model is compiled.
+            // Forward pass only Workspace (prediction) holds just the layer Z and Z activated, the rest of the buffers are empty.
+            struct Workspace final
+            {
+                // Z = WX + b of each layer
+                // input layer Z activated holds the input data, one data row per column
+                std::vector<Matrix> mLayerZ;
+                std::vector<Matrix> mLayerZActivated;
+
+                // dL/dZ of each layer calculated during backpropagation
+                std::vector<Matrix> mLayerDelta;
+
+                // dA/dZ of each layer calculated by the forward pass during training, consumed by backpropagation
+                std::vector<Matrix> mLayerActivationDer;
+
+                // expected output and loss of each output layer perceptron, one data row per column
+                Matrix mExpected;
+                Matrix mLoss;
+
+                // gradients calculated by backpropagation trough this Workspace
+                // same layout as the Model parameters buffer
+                Vector mGradients;
+
+                // loss of each output and metrics summed over all data rows propagated trough this Workspace in the current epoch
+                Vector mEpochLoss;
+                double mEpochMetrics;
+
+                // maximal number of data rows (columns) that fit into the Workspace
+                uint32_t mBatchCapacity;
+
+                // Allocate forward pass only Workspace buffers for the provided layers
+                // the Workspace can be used only for prediction (see Model::modelPredict())
+                Workspace(const std::vector<std::unique_ptr<Layers::Layer>>& layers, const uint32_t batchCapacity);
+
+                // Allocate training Workspace buffers for the provided layers
+                // parametersNo -> size of the Model parameters buffer
+                Workspace(const std::vector<std::unique_ptr<Layers::Layer>>& layers, const uint32_t batchCapacity, const Eigen::Index parametersNo);
+
+                // Delete default constructor
+                Workspace() = delete;
+
+                // Delete copy constructor
+                Workspace(Workspace& w) = delete;
+
+                // Delete copy assignment operator
+                Workspace& operator=(const Workspace& w) = delete;
+            };
+        }
+    }
+}
+
+#endif
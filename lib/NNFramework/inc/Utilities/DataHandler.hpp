@@ -3,8 +3,13 @@
 
 #include <memory>
 #include <iostream>
-#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
 #include "../Eigen/Dense"
+#include "../Common/Common.hpp"
+#include "Random.hpp"
+#include "Scaler.hpp"
 
 
 namespace NNFramework
@@ -31,20 +36,71 @@ namespace NNFramework
                 // Retrieve singleton object reference
                 static std::unique_ptr<DataHandler>& getInstance();
 
-                // Normalize data in range [0, 1]
-                Eigen::MatrixXd& normalizeData(Eigen::MatrixXd& data);
+                // Normalize data in range [0, 1], each column by its own min and max
+                // scaler is replaced by a MIN_MAX Scaler fitted to the data, it keeps the min and max of each column
+                Matrix& normalizeData(Matrix& data, Scaler::Scaler& scaler);
 
-                // Denormalize data from range [0, 1] to [min, max]
-                Eigen::MatrixXd& denormalizeData(Eigen::MatrixXd& data, double min, double max);
+                // Denormalize data from range [0, 1] to the [min, max] of each column
+                // scaler -> Scaler fitted by normalizeData(), e.g. of the expected data to denormalize the predictions
+                Matrix& denormalizeData(Matrix& data, const Scaler::Scaler& scaler);
 
                 // Shuffle data matrices
                 // shuffleData() shuffles data where original indices in inData matrix will match indices in expData matrix
                 // i.e. shuffleData() considers inData[0] and expData[0] to be a pair (inData[0], expData[0])
-                // works with original matrices 
-                void shuffleData(Eigen::MatrixXd& inData, Eigen::MatrixXd& expData);
+                // works with original matrices, only the row indices are shuffled and the columns are gathered trough them
+                // each shuffle takes its own stream of the global seed (see Random.hpp)
+                // training does not need shuffled matrices, data sources shuffle only the row indices (see shuffleIndices())
+                void shuffleData(Matrix& inData, Matrix& expData);
+
+                // Shuffle row indices (Fisher-Yates), only the indices are moved
+                void shuffleIndices(std::vector<Eigen::Index>& indices, Random::Xoshiro256& engine) const;
+
+                // Gather data rows indices[firstIdx, firstIdx + rowsNo) of data into the leftmost rowsNo columns of batch
+                // batch has data.cols() rows, i.e. each data row is written as one column of the batch
+                void gatherRows(const Matrix& data, const std::vector<Eigen::Index>& indices, const size_t firstIdx, const Eigen::Index rowsNo, Eigen::Ref<Matrix> batch) const;
+
+                // Same as gatherRows() above, each gathered value is scaled by the scaler on the way (see Scaler.hpp)
+                void gatherRows(const Matrix& data, const std::vector<Eigen::Index>& indices, const size_t firstIdx, const Eigen::Index rowsNo, 
+                                const Scaler::Scaler& scaler, Eigen::Ref<Matrix> batch) const;
+
+                // Load data from the text file into a Matrix
+                // one data row per line, values are separated by blank spaces, tabs or commas, empty lines are skipped
+                // number of rows and columns is inferred from the file, every data row has to have the same number of values
+                // file is memory mapped, split into chunks at line boundaries and the chunks are parsed in parallel
+                // threadsNo = 0 -> one thread per hardware thread, small files are always parsed by a single thread
+                Matrix loadData(const std::string& path, const uint16_t threadsNo = 0U);
+
+                // Load data from the text file and split each data row into input data and expected data
+                // Same as loadData() above, first inCol values of each data row are input data, next expCol values are expected data
+                // Return values: tuple[0] = input data, tuple[1] = expected data
+                std::tuple<Matrix, Matrix> loadData(const std::string& path, const uint32_t inCol, const uint32_t expCol, const uint16_t threadsNo = 0U);
+
+                // Text data parsing used by loadData(), for data sources that parse the text data in parts
+                // [begin, end) has to start at the beginning of a line and end at the end of a line
+
+                // Split [begin, end) into chunksNo chunks of about the same size at line boundaries
+                // Return value: chunksNo + 1 bounds, chunk i is [bounds[i], bounds[i + 1])
+                std::vector<const char*> splitData(const char* begin, const char* end, const size_t chunksNo) const;
+
+                // Number of values in the first data row of [begin, end), 0 if there is no data row
+                Eigen::Index countDataColumns(const char* begin, const char* end) const;
+
+                // Number of data rows in [begin, end)
+                Eigen::Index countDataRows(const char* begin, const char* end) const;
+
+                // Parse data rows of [begin, end) into the rows of inData and expData starting at rowIdx
+                // first inData.cols() values of each data row are written into inData and the rest into expData
+                void parseDataRows(const char* begin, const char* end, const Eigen::Index rowIdx, Matrix& inData, Matrix& expData) const;
 
             private:
+                // Minimum size of the file chunk parsed by one thread in bytes
+                static constexpr size_t LOAD_CHUNK_MIN_SIZE = 1U << 20U;
+
                 DataHandler() { }
+
+                // Parse data rows of the text file into inData (first inData.cols() values) and expData (remaining values)
+                // inCol = 0 -> number of columns is inferred from the file and all values are parsed into inData
+                void parseDataFile(const std::string& path, const uint16_t threadsNo, const uint32_t inCol, const uint32_t expCol, Matrix& inData, Matrix& expData) const;
         };
     }
 }
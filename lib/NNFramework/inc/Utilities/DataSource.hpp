@@ -0,0 +1,307 @@
+#ifndef DATASOURCE_UTILITIES_HPP
+#define DATASOURCE_UTILITIES_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <atomic>
+#include "../Eigen/Dense"
+#include "Dataset.hpp"
+#include "MappedFile.hpp"
+#include "SpscQueue.hpp"
+#include "Random.hpp"
+#include "Scaler.hpp"
+#include "../Common/Common.hpp"
+
+namespace NNFramework
+{
+    namespace DataSource
+    {
+        // Source of the training data for Model.modelFit()
+        // Data rows are taken in batches. Each data row of the batch is written as one column of the batch matrices,
+        // which is the layout of the input layer and expected output of the Workspace, thus batches are written
+        // directly into the Workspace of the training thread.
+        class DataSource
+        {
+            public:
+                virtual ~DataSource() = default;
+
+                virtual std::string name() const = 0;
+
+                // Number of input data and expected data values in one data row
+                virtual uint32_t inputColsNo() const = 0;
+                virtual uint32_t expectedColsNo() const = 0;
+
+                // Number of data rows in one epoch, 0 if it is not known in advance
+                virtual uint64_t rowsNo() const = 0;
+
+                // Start a new epoch
+                // shuffle = true -> data rows are taken in a new random order
+                // shuffle = false -> data rows are taken in the same order as in the previous epoch
+                virtual void reset(const bool shuffle) = 0;
+
+                // Take the next data rows of the epoch, at most inBatch.cols() rows
+                // inBatch has inputColsNo() rows and expBatch has expectedColsNo() rows
+                // Return value: number of data rows written into the leftmost columns of inBatch and expBatch, 0 at the end of the epoch
+                virtual uint32_t nextBatch(Eigen::Ref<Matrix> inBatch, Eigen::Ref<Matrix> expBatch) = 0;
+
+                // Scale data rows while they are taken, nullptr -> values are taken as they are (default)
+                // scalers are fitted in advance (see Scaler.hpp) and they have to outlive the data source
+                // MatrixDataSource and the block data sources scale the values while the rows are gathered into the batch,
+                // other data sources scale each batch after it is taken
+                virtual void setScalers(const Scaler::Scaler* inScaler, const Scaler::Scaler* expScaler);
+
+            protected:
+                const Scaler::Scaler* mInScaler = nullptr;
+                const Scaler::Scaler* mExpScaler = nullptr;
+
+                // Scale the batches by the scalers
+                void scaleBatch(Eigen::Ref<Matrix> inBatch, Eigen::Ref<Matrix> expBatch) const;
+        };
+
+        // Data held in memory
+        // rows are read trough the shuffled row indices, matrices are never copied nor modified
+        // inData and expData have to outlive the data source
+        class MatrixDataSource final : public DataSource
+        {
+            public:
+                MatrixDataSource(const Matrix& inData, const Matrix& expData);
+
+                std::string name() const override
+                {
+                    return "MatrixDataSource";
+                }
+
+                uint32_t inputColsNo() const override { return static_cast<uint32_t>(mInData.cols()); }
+                uint32_t expectedColsNo() const override { return static_cast<uint32_t>(mExpData.cols()); }
+                uint64_t rowsNo() const override { return static_cast<uint64_t>(mInData.rows()); }
+
+                void reset(const bool shuffle) override;
+                uint32_t nextBatch(Eigen::Ref<Matrix> inBatch, Eigen::Ref<Matrix> expBatch) override;
+
+            private:
+                const Matrix& mInData;
+                const Matrix& mExpData;
+                std::vector<Eigen::Index> mRowsOrder;
+                size_t mNextRow;
+                Random::Xoshiro256 mEngine;
+        };
+
+        // Data that does not fit into memory, split into blocks of data rows
+        // only one block is held in memory at a time
+        // shuffle changes the order of the blocks and the order of the data rows inside of each block
+        class BlockDataSource : public DataSource
+        {
+            public:
+                void reset(const bool shuffle) override;
+                uint32_t nextBatch(Eigen::Ref<Matrix> inBatch, Eigen::Ref<Matrix> expBatch) override;
+
+            protected:
+                BlockDataSource();
+
+                // Number of blocks of the data
+                virtual size_t blocksNo() const = 0;
+
+                // Load data rows of the block into inBlock and expBlock (one data row per matrix row)
+                virtual void loadBlock(const size_t blockIdx, Matrix& inBlock, Matrix& expBlock) = 0;
+
+                // Number of data rows taken in the last complete epoch, 0 before the first epoch is complete
+                uint64_t mEpochRowsNo;
+
+            private:
+                std::vector<Eigen::Index> mBlocksOrder;
+                size_t mNextBlock;
+                size_t mLoadedBlock;        // index of the block held in mInBlock and mExpBlock, NO_BLOCK if none
+                Matrix mInBlock;
+                Matrix mExpBlock;
+                std::vector<Eigen::Index> mRowsOrder;
+                size_t mNextRow;
+                uint64_t mRowsTaken;
+                bool mShuffled;             // rows of the blocks are shuffled
+                uint64_t mEpochSeed;        // seed of the rows order of the blocks, the same order is used until next shuffle
+                Random::Xoshiro256 mEngine;
+
+                static constexpr size_t NO_BLOCK = static_cast<size_t>(-1);
+
+                // Load the block if it is not loaded yet and set up the order of its data rows
+                void startBlock(const size_t blockIdx);
+        };
+
+        // Selected columns of the binary columnar dataset (see Dataset.hpp)
+        // each block of blockRows data rows is gathered directly from the memory mapped dataset shards
+        // dataset has to outlive the data source
+        class DatasetDataSource final : public BlockDataSource
+        {
+            public:
+                DatasetDataSource(const Dataset::Dataset& dataset, const std::vector<std::string>& inColumns, const std::vector<std::string>& expColumns,
+                                  const uint64_t blockRows = 65536U);
+
+                std::string name() const override
+                {
+                    return "DatasetDataSource";
+                }
+
+                uint32_t inputColsNo() const override { return static_cast<uint32_t>(mInColumnsIdx.size()); }
+                uint32_t expectedColsNo() const override { return static_cast<uint32_t>(mExpColumnsIdx.size()); }
+                uint64_t rowsNo() const override { return mDataset.get_mRowsNo(); }
+
+            protected:
+                size_t blocksNo() const override;
+                void loadBlock(const size_t blockIdx, Matrix& inBlock, Matrix& expBlock) override;
+
+            private:
+                const Dataset::Dataset& mDataset;
+                std::vector<uint32_t> mInColumnsIdx;
+                std::vector<uint32_t> mExpColumnsIdx;
+                uint64_t mBlockRows;
+        };
+
+        // Text data file (see DataHandler.loadData()) parsed in chunks
+        // the file is memory mapped and split into chunks of about chunkSize bytes at line boundaries,
+        // each chunk is parsed when its data rows are needed
+        class TextDataSource final : public BlockDataSource
+        {
+            public:
+                TextDataSource(const std::string& path, const uint32_t inCol, const uint32_t expCol, const size_t chunkSize = 16U << 20U);
+
+                std::string name() const override
+                {
+                    return "TextDataSource";
+                }
+
+                uint32_t inputColsNo() const override { return mInCol; }
+                uint32_t expectedColsNo() const override { return mExpCol; }
+
+                // number of data rows is known after the first epoch
+                uint64_t rowsNo() const override { return mEpochRowsNo; }
+
+            protected:
+                size_t blocksNo() const override;
+                void loadBlock(const size_t blockIdx, Matrix& inBlock, Matrix& expBlock) override;
+
+            private:
+                std::unique_ptr<MappedFile::MappedFile> mDataFilePtr;
+                std::vector<const char*> mChunkBounds;  // chunk i is [mChunkBounds[i], mChunkBounds[i + 1])
+                uint32_t mInCol;
+                uint32_t mExpCol;
+        };
+
+        // Data produced by the user supplied generator
+        // generator writes at most inBatch.cols() data rows into the leftmost columns of inBatch and expBatch
+        // and returns the number of written data rows, 0 ends the epoch
+        class GeneratorDataSource final : public DataSource
+        {
+            public:
+                using Generator = std::function<uint32_t(Eigen::Ref<Matrix> inBatch, Eigen::Ref<Matrix> expBatch)>;
+
+                // rowsPerEpoch = 0 -> epoch ends when generator returns 0
+                GeneratorDataSource(Generator generator, const uint32_t inputColsNo, const uint32_t expectedColsNo, const uint64_t rowsPerEpoch = 0U);
+
+                std::string name() const override
+                {
+                    return "GeneratorDataSource";
+                }
+
+                uint32_t inputColsNo() const override { return mInputColsNo; }
+                uint32_t expectedColsNo() const override { return mExpectedColsNo; }
+                uint64_t rowsNo() const override { return mRowsPerEpoch; }
+
+                // order of the data rows is given by the generator, shuffle is ignored
+                void reset(const bool shuffle) override;
+                uint32_t nextBatch(Eigen::Ref<Matrix> inBatch, Eigen::Ref<Matrix> expBatch) override;
+
+            private:
+                Generator mGenerator;
+                uint32_t mInputColsNo;
+                uint32_t mExpectedColsNo;
+                uint64_t mRowsPerEpoch;
+                uint64_t mRowsTaken;
+        };
+
+        // Data source that prepares the next batches of the wrapped data source on a separate producer thread
+        // Producer takes the batches of the wrapped data source (gather, parsing, type conversion) and applies the optional
+        // transform (e.g. normalization) into a ring of prefetchDepth preallocated batch buffers, while the training
+        // thread consumes the previous batches. Batches are handed over trough the lock-free SPSC queue.
+        // Producer starts the next epoch as soon as reset() is called (the first epoch starts with the first nextBatch()).
+        // Wrapped data source is used only by the producer thread and it has to outlive the prefetching data source.
+        class PrefetchDataSource final : public DataSource
+        {
+            public:
+                // Transform applied by the producer to each batch (data rows as columns)
+                using Transform = std::function<void(Eigen::Ref<Matrix> inBatch, Eigen::Ref<Matrix> expBatch)>;
+
+                PrefetchDataSource(DataSource& source, const uint32_t prefetchDepth = 2U, Transform transform = nullptr);
+
+                // Stop the producer thread
+                ~PrefetchDataSource();
+
+                // Delete copy constructor
+                PrefetchDataSource(PrefetchDataSource& p) = delete;
+
+                // Delete copy assignment operator
+                PrefetchDataSource& operator=(const PrefetchDataSource& p) = delete;
+
+                std::string name() const override
+                {
+                    return "PrefetchDataSource";
+                }
+
+                uint32_t inputColsNo() const override { return mSource.inputColsNo(); }
+                uint32_t expectedColsNo() const override { return mSource.expectedColsNo(); }
+                uint64_t rowsNo() const override { return mRowsNo.load(std::memory_order_relaxed); }
+
+                void reset(const bool shuffle) override;
+
+                // every call of one epoch has to request the same number of data rows
+                uint32_t nextBatch(Eigen::Ref<Matrix> inBatch, Eigen::Ref<Matrix> expBatch) override;
+
+                // Scalers are set on the wrapped data source, which has to be done before the training
+                void setScalers(const Scaler::Scaler* inScaler, const Scaler::Scaler* expScaler) override;
+
+            private:
+                // One prefetched batch
+                struct Batch final
+                {
+                    Matrix inBatch;
+                    Matrix expBatch;
+                    uint32_t rows = 0U;                 // 0 -> end of the epoch
+                    std::exception_ptr error = nullptr; // exception thrown by the wrapped data source
+                };
+
+                DataSource& mSource;
+                Transform mTransform;
+                SpscQueue::SpscQueue<Batch> mQueue;
+                std::atomic<uint64_t> mRowsNo;      // rowsNo() of the wrapped data source, updated by the producer
+
+                // producer control, not used on the hot path
+                std::mutex mMutex;
+                std::condition_variable mCv;
+                bool mEpochRequested;
+                bool mStop;
+                std::atomic<bool> mCancel;          // producer ends the current epoch early
+
+                // consumer state
+                Eigen::Index mBatchCols;            // number of data rows requested by nextBatch(), 0 if not known yet
+                bool mEpochRunning;                 // producer works on the current epoch, end of the epoch is not consumed yet
+                bool mEpochDone;                    // end of the current epoch is consumed
+
+                std::thread mProducerThread;
+
+                // Start producing batches of batchCols data rows for the current epoch
+                void startEpoch(const Eigen::Index batchCols);
+
+                // End current epoch of the producer, prefetched batches are dropped
+                void cancelEpoch();
+
+                // Producer thread loop
+                void producerLoop();
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef DATASET_UTILITIES_HPP
+#define DATASET_UTILITIES_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "../Eigen/Dense"
+#include "DatasetFile.hpp"
+#include "MappedFile.hpp"
+#include "../Common/Common.hpp"
+
+namespace NNFramework
+{
+    namespace Dataset
+    {
+        // Statistics of one dataset column
+        struct ColumnStats final
+        {
+            double min;
+            double max;
+            double mean;
+            double stdDev;
+        };
+
+        // Binary columnar dataset (see DatasetFile.hpp) memory mapped from its shard files
+        // Columns are selected by name and read directly from the mapped shards, pages of the columns
+        // that are never read are never loaded. Values are converted to Scalar while they are gathered.
+        class Dataset final
+        {
+            public:
+                // Map all shards of the dataset (<path>.0, <path>.1, ...)
+                // throws an exception if shards are missing or do not belong to the same dataset
+                Dataset(const std::string& path);
+
+                // Delete default constructor
+                Dataset() = delete;
+
+                // Delete copy constructor
+                Dataset(Dataset& d) = delete;
+
+                // Delete copy assignment operator
+                Dataset& operator=(const Dataset& d) = delete;
+
+                // Convert data into the binary columnar dataset
+                // one column name and role for each column of data, data rows are split into shards of shardRowsNo rows
+                // shardRowsNo = 0 -> single shard
+                // Return value: true if all shards are written
+                static bool saveDataset(const std::string& path, const Eigen::Ref<const Matrix>& data, const std::vector<std::string>& columnNames,
+                                        const std::vector<DatasetFile::ColumnRole>& columnRoles, const uint64_t shardRowsNo = 0U,
+                                        const DatasetFile::DataType dataType = (sizeof(Scalar) == sizeof(float)) ? DatasetFile::FLOAT32 : DatasetFile::FLOAT64);
+
+                // Path of the dataset shard
+                static std::string shardPath(const std::string& path, const uint32_t shardIdx);
+
+                // Index of the column with the given name
+                // throws an exception if the dataset has no such column
+                uint32_t columnIdx(const std::string& columnName) const;
+
+                // Names of all columns with the given role, in the stored order
+                std::vector<std::string> columnNames(const DatasetFile::ColumnRole role) const;
+
+                // Copy rows [firstRow, firstRow + out.rows()) of the selected columns into out
+                // column i of out is filled with the values of the dataset column columnsIdx[i], rows may span multiple shards
+                void gatherColumns(const std::vector<uint32_t>& columnsIdx, const uint64_t firstRow, Eigen::Ref<Matrix> out) const;
+
+                // Copy all rows of the named columns into a new Matrix
+                Matrix loadColumns(const std::vector<std::string>& columnNames) const;
+
+                // Getters
+                uint64_t get_mRowsNo() const noexcept { return this->mShardFirstRow.back(); }
+                uint32_t get_mColumnsNo() const noexcept { return static_cast<uint32_t>(this->mColumns.size()); }
+                uint32_t get_mShardsNo() const noexcept { return static_cast<uint32_t>(this->mShards.size()); }
+                const std::string& get_mColumnName(const uint32_t columnIdx) const { return this->mColumns.at(columnIdx).name; }
+                DatasetFile::ColumnRole get_mColumnRole(const uint32_t columnIdx) const { return this->mColumns.at(columnIdx).role; }
+                DatasetFile::DataType get_mColumnDataType(const uint32_t columnIdx) const { return this->mColumns.at(columnIdx).dataType; }
+                const ColumnStats& get_mColumnStats(const uint32_t columnIdx) const { return this->mColumns.at(columnIdx).stats; }
+
+            private:
+                // Column description shared by all shards
+                struct Column final
+                {
+                    std::string name;
+                    DatasetFile::ColumnRole role;
+                    DatasetFile::DataType dataType;
+                    ColumnStats stats;
+                };
+
+                std::vector<Column> mColumns;
+                std::vector<std::unique_ptr<MappedFile::MappedFile>> mShards;
+                std::vector<uint64_t> mShardFirstRow;                 // first row of each shard, last element is the number of rows
+                std::vector<std::vector<const uint8_t*>> mColumnData;  // mapped blob of each column in each shard, [shardIdx][columnIdx]
+
+                // Validate shard header and column records, record the columns of the first shard
+                void readShard(const std::string& shardPath, const uint32_t shardIdx, uint32_t& shardsNo);
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef DATASETFILE_UTILITIES_HPP
+#define DATASETFILE_UTILITIES_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+namespace NNFramework
+{
+    namespace Dataset
+    {
+        namespace DatasetFile
+        {
+            // Binary columnar dataset shard layout (native byte order):
+            //
+            // Header                       (48 bytes)
+            // ColumnRecord x columnsNo     (80 bytes each)
+            // padding up to the first column
+            // column blobs                 (rowsNo x dataType bytes each, every blob is aligned to COLUMN_ALIGNMENT)
+            //
+            // Dataset is split into shardsNo shard files (<path>.0, <path>.1, ...), each shard holds a contiguous range of
+            // data rows. Every shard holds the same column records, column statistics describe the whole dataset.
+            // Values of one column are stored contiguously, thus reading a subset of columns never touches
+            // pages of the other columns of a memory mapped shard.
+
+            constexpr char MAGIC[4] = { 'N', 'N', 'D', 'S' };
+            constexpr uint32_t VERSION = 1U;
+            constexpr uint64_t COLUMN_ALIGNMENT = 64U;
+            constexpr size_t COLUMN_NAME_SIZE = 32U;
+
+            // Role of the column in the training
+            enum ColumnRole : uint8_t
+            {
+                INPUT_COLUMN = 0U,
+                LABEL_COLUMN
+            };
+
+            // Type of the stored values, value equals to the size of one value in bytes
+            enum DataType : uint8_t
+            {
+                FLOAT32 = 4U,
+                FLOAT64 = 8U
+            };
+
+            struct Header final
+            {
+                char magic[4];
+                uint32_t version;
+                uint32_t columnsNo;
+                uint32_t shardIdx;
+                uint32_t shardsNo;
+                uint32_t reserved;
+                uint64_t rowsNo;            // number of data rows in this shard
+                uint64_t firstRow;          // index of the first data row of this shard in the dataset
+                uint64_t datasetRowsNo;     // number of data rows in all shards
+            };
+
+            struct ColumnRecord final
+            {
+                char name[COLUMN_NAME_SIZE];    // zero terminated column name
+                uint8_t role;                   // ColumnRole
+                uint8_t dataType;               // DataType
+                uint8_t reserved[6];
+                uint64_t dataOffset;            // offset of the column blob from the beginning of the shard file
+
+                // statistics of the column over the whole dataset
+                double min;
+                double max;
+                double mean;
+                double stdDev;
+            };
+
+            static_assert(sizeof(Header) == 48U, "Unexpected dataset file header size");
+            static_assert(sizeof(ColumnRecord) == 80U, "Unexpected dataset file column record size");
+
+            // Round offset up to the column alignment
+            constexpr uint64_t alignOffset(const uint64_t offset)
+            {
+                return ((offset + COLUMN_ALIGNMENT - 1U) / COLUMN_ALIGNMENT) * COLUMN_ALIGNMENT;
+            }
+
+            // Offset of the first column blob for the given number of columns
+            constexpr uint64_t columnsOffset(const uint32_t columnsNo)
+            {
+                return alignOffset(sizeof(Header) + (static_cast<uint64_t>(columnsNo) * sizeof(ColumnRecord)));
+            }
+        }
+    }
+}
+
+#endif
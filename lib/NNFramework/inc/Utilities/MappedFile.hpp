@@ -0,0 +1,55 @@
+#ifndef MAPPEDFILE_UTILITIES_HPP
+#define MAPPEDFILE_UTILITIES_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace NNFramework
+{
+    namespace MappedFile
+    {
+        // How the file is mapped into memory
+        enum class MapMode : uint8_t
+        {
+            READ_ONLY = 0U,     // pages are shared with every other mapping of the file, writes are not allowed
+            COPY_ON_WRITE       // pages are shared until written, written pages become private to the process, file is never modified
+        };
+
+        // Whole file mapped into the address space of the process (mmap on POSIX, MapViewOfFile on Windows).
+        // Pages are loaded on first access, thus mapping is fast regardless of the file size and
+        // all processes mapping the same file share one physical copy of the unmodified pages.
+        class MappedFile final
+        {
+            public:
+                // Map the whole file
+                MappedFile(const std::string& path, const MapMode mode = MapMode::READ_ONLY);
+
+                // Unmap the file
+                ~MappedFile();
+
+                // Delete default constructor
+                MappedFile() = delete;
+
+                // Delete copy constructor
+                MappedFile(MappedFile& m) = delete;
+
+                // Delete copy assignment operator
+                MappedFile& operator=(const MappedFile& m) = delete;
+
+                // Getters
+                // mapped memory is aligned at least to the page size, nullptr for an empty file
+                const uint8_t* data() const noexcept { return this->mData; }
+                uint8_t* data() noexcept { return this->mData; }
+                size_t size() const noexcept { return this->mSize; }
+                MapMode mode() const noexcept { return this->mMode; }
+
+            private:
+                uint8_t* mData;
+                size_t mSize;
+                MapMode mMode;
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef RANDOM_UTILITIES_HPP
+#define RANDOM_UTILITIES_HPP
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include "../Eigen/Dense"
+#include "../Common/Common.hpp"
+
+namespace NNFramework
+{
+    namespace Random
+    {
+        // SplitMix64 step, used to expand a single 64 bit seed into the state of the random engines
+        inline uint64_t splitMix64(uint64_t& state)
+        {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+
+            return z ^ (z >> 31U);
+        }
+
+        // Seed of the stream streamIdx of the seed, different streams give unrelated sequences
+        inline uint64_t mixSeed(const uint64_t seed, const uint64_t streamIdx)
+        {
+            uint64_t state = seed ^ (streamIdx * 0xD1B54A32D192ED03ULL);
+
+            return splitMix64(state);
+        }
+
+        // xoshiro256** random engine
+        // a few shifts and rotations per 64 bit value and 32 bytes of state, satisfies UniformRandomBitGenerator
+        // the same seed always gives the same sequence on every platform
+        class Xoshiro256 final
+        {
+            public:
+                using result_type = uint64_t;
+
+                explicit Xoshiro256(const uint64_t seed = 0U)
+                {
+                    this->seed(seed);
+                }
+
+                void seed(uint64_t seed)
+                {
+                    for(uint64_t& s : mState)
+                    {
+                        s = splitMix64(seed);
+                    }
+                }
+
+                static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+                static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+                result_type operator()()
+                {
+                    const uint64_t result = rotl(mState[1] * 5U, 7U) * 9U;
+                    const uint64_t t = mState[1] << 17U;
+
+                    mState[2] ^= mState[0];
+                    mState[3] ^= mState[1];
+                    mState[1] ^= mState[2];
+                    mState[0] ^= mState[3];
+                    mState[2] ^= t;
+                    mState[3] = rotl(mState[3], 45U);
+
+                    return result;
+                }
+
+            private:
+                std::array<uint64_t, 4> mState;
+
+                static constexpr uint64_t rotl(const uint64_t x, const unsigned k)
+                {
+                    return (x << k) | (x >> (64U - k));
+                }
+        };
+
+        // Uniformly distributed integer in [0, bound)
+        // bounds up to 2^32: multiply-shift with rejection of the biased values (Lemire), no division in the common case
+        inline uint64_t uniformIndex(Xoshiro256& engine, const uint64_t bound)
+        {
+            if(bound > (static_cast<uint64_t>(1U) << 32U))
+            {
+                return std::uniform_int_distribution<uint64_t>(0U, bound - 1U)(engine);
+            }
+
+            uint64_t m = (engine() >> 32U) * bound;
+            uint32_t l = static_cast<uint32_t>(m);
+
+            if(l < bound)
+            {
+                const uint32_t threshold = static_cast<uint32_t>((static_cast<uint64_t>(1U) << 32U) % bound);
+                while(l < threshold)
+                {
+                    m = (engine() >> 32U) * bound;
+                    l = static_cast<uint32_t>(m);
+                }
+            }
+
+            return m >> 32U;
+        }
+
+        // Global seed of the library
+        // every random engine of NNFramework (weights initialization, data shuffle, data sources) is seeded from the global seed,
+        // thus the same global seed gives the same run. Without setGlobalSeed() the global seed is taken from std::random_device.
+        void setGlobalSeed(const uint64_t seed);
+        uint64_t globalSeed();
+
+        // Seed of the next stream of the global seed, streams are numbered in the order of nextSeed() calls
+        // setGlobalSeed() restarts the numbering
+        uint64_t nextSeed();
+
+        // Random engine of the stream streamIdx of the global seed, e.g. one independent stream per thread
+        // the stream depends only on the global seed and streamIdx, not on the order of the calls
+        Xoshiro256 stream(const uint64_t streamIdx);
+
+        // Bulk generation of uniformly distributed values in [low, high) and normally distributed values
+        // Values are generated in blocks of FILL_BLOCK_SIZE values, each block by its own engine seeded with (seed, block index),
+        // and each engine runs FILL_LANES_NO independent xoshiro256** lanes in lockstep so that the compiler vectorizes them.
+        // Blocks are split across threadsNo threads (0 -> one thread per hardware thread), the values do not depend on threadsNo.
+        // out is filled in column major order.
+        void fillUniform(Eigen::Ref<Matrix> out, const Scalar low, const Scalar high, const uint64_t seed, const uint16_t threadsNo = 0U);
+        void fillNormal(Eigen::Ref<Matrix> out, const Scalar mean, const Scalar stdDev, const uint64_t seed, const uint16_t threadsNo = 0U);
+
+        // Number of values generated by one block engine
+        constexpr size_t FILL_BLOCK_SIZE = 4096U;
+        // Number of xoshiro256** lanes of the block engine
+        constexpr size_t FILL_LANES_NO = 8U;
+    }
+}
+#endif
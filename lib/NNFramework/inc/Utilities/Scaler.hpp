@@ -0,0 +1,105 @@
+#ifndef SCALER_UTILITIES_HPP
+#define SCALER_UTILITIES_HPP
+
+#include <string>
+#include <vector>
+#include "../Eigen/Dense"
+#include "../Common/Common.hpp"
+#include "Dataset.hpp"
+
+namespace NNFramework
+{
+    namespace Scaler
+    {
+        // Per column feature scaler
+        // Statistics of each column (count, mean, sum of squared deviations, min, max) are collected in a single pass over the data
+        // and can be collected in parts (partialFit()) and merged (merge()), e.g. per thread, per data chunk or per dataset shard.
+        // Scaling is affine per column: scaled = (x - offset) * scale
+        // MIN_MAX -> values in range [0, 1], STANDARD -> zero mean and unit standard deviation
+        // constant columns are only shifted (scale = 1)
+        class Scaler final
+        {
+            public:
+                enum ScalerType : uint8_t
+                {
+                    MIN_MAX = 0U,
+                    STANDARD = 1U
+                };
+
+                explicit Scaler(const ScalerType type = MIN_MAX);
+
+                // Drop collected statistics
+                void reset();
+
+                // Collect statistics of the data, one data row per matrix row
+                // rows are split across threadsNo threads (0 -> one thread per hardware thread), small data is processed by a single thread
+                void partialFit(const Eigen::Ref<const Matrix>& data, const uint16_t threadsNo = 0U);
+
+                // Collect statistics of the data only, previously collected statistics are dropped
+                void fit(const Eigen::Ref<const Matrix>& data, const uint16_t threadsNo = 0U);
+
+                // Take statistics of the named dataset columns saved in the dataset shards, no data is read
+                void fit(const Dataset::Dataset& dataset, const std::vector<std::string>& columnNames);
+
+                // Add statistics collected by the other scaler of the same columns
+                void merge(const Scaler& other);
+
+                // Scale data in place, one data row per matrix row
+                // rows are split across threadsNo threads (0 -> one thread per hardware thread), small data is processed by a single thread
+                void transform(Eigen::Ref<Matrix> data, const uint16_t threadsNo = 0U) const;
+
+                // Undo the scaling of data in place, e.g. of the predictions
+                void inverseTransform(Eigen::Ref<Matrix> data, const uint16_t threadsNo = 0U) const;
+
+                // Scale batch in place, one data row per batch column (layout of the DataSource batches)
+                void transformBatch(Eigen::Ref<Matrix> batch) const;
+
+                // Save collected statistics, the scaler can be loaded and merged with new statistics afterwards
+                // Return value: true if the scaler file is written
+                bool saveScaler(const std::string& path) const;
+
+                // Load statistics saved by saveScaler()
+                // Return value: true if the scaler file is loaded, the scaler is not modified otherwise
+                bool loadScaler(const std::string& path);
+
+                // Standard deviation of each column
+                Eigen::VectorXd stdDev() const;
+
+                // Getters
+                ScalerType get_mType() const noexcept { return this->mType; }
+                uint32_t get_mColumnsNo() const noexcept { return static_cast<uint32_t>(this->mMean.size()); }
+                uint64_t get_mCount() const noexcept { return this->mCount; }
+                const Eigen::VectorXd& get_mMean() const noexcept { return this->mMean; }
+                const Eigen::VectorXd& get_mMin() const noexcept { return this->mMin; }
+                const Eigen::VectorXd& get_mMax() const noexcept { return this->mMax; }
+                const Vector& get_mOffset() const noexcept { return this->mOffset; }
+                const Vector& get_mScale() const noexcept { return this->mScale; }
+
+            private:
+                // Number of data rows of a column processed at once, statistics of each block are merged into the column statistics
+                static constexpr Eigen::Index FIT_BLOCK_ROWS = 1024;
+                // Minimum number of values processed by one thread
+                static constexpr Eigen::Index MIN_THREAD_VALUES = 1 << 16;
+
+                ScalerType mType;
+                uint64_t mCount;            // number of data rows
+                Eigen::VectorXd mMean;      // mean of each column
+                Eigen::VectorXd mM2;        // sum of squared deviations from the mean of each column
+                Eigen::VectorXd mMin;
+                Eigen::VectorXd mMax;
+                Vector mOffset;             // scaled = (x - mOffset) * mScale
+                Vector mScale;
+
+                // Merge statistics (count, mean, m2, min, max) of data rows into the statistics of the scaler
+                void mergeStats(const uint64_t count, const Eigen::VectorXd& mean, const Eigen::VectorXd& m2, const Eigen::VectorXd& min, const Eigen::VectorXd& max);
+
+                // Compute mOffset and mScale from the statistics
+                void updateAffine();
+
+                // Check if the scaler is fitted and matches the number of columns
+                void checkColumnsNo(const std::string fName, const Eigen::Index columnsNo) const;
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef SCALERFILE_UTILITIES_HPP
+#define SCALERFILE_UTILITIES_HPP
+
+#include <cstdint>
+
+namespace NNFramework
+{
+    namespace Scaler
+    {
+        namespace ScalerFile
+        {
+            // Binary scaler file layout (native byte order):
+            //
+            // Header                       (24 bytes)
+            // mean   x columnsNo           (double)
+            // m2     x columnsNo           (double, sum of squared deviations from the mean)
+            // min    x columnsNo           (double)
+            // max    x columnsNo           (double)
+            //
+            // Statistics are saved instead of the scaling parameters, thus a loaded scaler can still be merged.
+
+            constexpr char MAGIC[4] = { 'N', 'N', 'S', 'C' };
+            constexpr uint32_t VERSION = 1U;
+
+            struct Header final
+            {
+                char magic[4];
+                uint32_t version;
+                uint32_t type;              // Scaler::ScalerType
+                uint32_t columnsNo;
+                uint64_t count;             // number of data rows the statistics are collected from
+            };
+
+            static_assert(sizeof(Header) == 24U, "Unexpected scaler file header size");
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef SPSCQUEUE_UTILITIES_HPP
+#define SPSCQUEUE_UTILITIES_HPP
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <new>
+
+namespace NNFramework
+{
+    namespace SpscQueue
+    {
+        // Lock-free single producer single consumer queue of preallocated slots
+        // Slots are filled and read in place, thus no element is ever copied nor allocated after construction:
+        // producer: acquireBack() -> fill the slot -> commitBack()
+        // consumer: acquireFront() -> read the slot -> releaseFront()
+        // acquire calls block (std::atomic::wait) while the queue is full or empty
+        template<class T>
+        class SpscQueue final
+        {
+            public:
+                // Construct queue of capacity slots, each slot is a copy of prototype
+                SpscQueue(const size_t capacity, const T& prototype = T()) : mSlots(capacity, prototype), mHead(0U), mTail(0U) { }
+
+                // Delete default constructor
+                SpscQueue() = delete;
+
+                // Delete copy constructor
+                SpscQueue(SpscQueue& q) = delete;
+
+                // Delete copy assignment operator
+                SpscQueue& operator=(const SpscQueue& q) = delete;
+
+                // Producer: wait for a free slot
+                T& acquireBack()
+                {
+                    const size_t tail = mTail.load(std::memory_order_relaxed);
+                    size_t head = mHead.load(std::memory_order_acquire);
+
+                    while((tail - head) >= mSlots.size())
+                    {
+                        mHead.wait(head, std::memory_order_acquire);
+                        head = mHead.load(std::memory_order_acquire);
+                    }
+
+                    return mSlots[tail % mSlots.size()];
+                }
+
+                // Producer: publish the slot returned by acquireBack()
+                void commitBack()
+                {
+                    mTail.fetch_add(1U, std::memory_order_release);
+                    mTail.notify_one();
+                }
+
+                // Consumer: wait for a published slot
+                T& acquireFront()
+                {
+                    const size_t head = mHead.load(std::memory_order_relaxed);
+                    size_t tail = mTail.load(std::memory_order_acquire);
+
+                    while(tail == head)
+                    {
+                        mTail.wait(tail, std::memory_order_acquire);
+                        tail = mTail.load(std::memory_order_acquire);
+                    }
+
+                    return mSlots[head % mSlots.size()];
+                }
+
+                // Consumer: return the slot returned by acquireFront() to the producer
+                void releaseFront()
+                {
+                    mHead.fetch_add(1U, std::memory_order_release);
+                    mHead.notify_one();
+                }
+
+                // Slots, may be resized only while neither producer nor consumer use the queue
+                std::vector<T>& slots() noexcept { return this->mSlots; }
+
+            private:
+                std::vector<T> mSlots;
+
+                // head and tail are written by different threads, keep them on separate cache lines
+                alignas(64) std::atomic<size_t> mHead;  // slots read by the consumer
+                alignas(64) std::atomic<size_t> mTail;  // slots published by the producer
+        };
+    }
+}
+
+#endif
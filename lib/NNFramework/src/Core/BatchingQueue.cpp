@@ -0,0 +1,266 @@
+#include "Core/BatchingQueue.hpp"
+#include <iostream>
+#include <algorithm>
+
+namespace NNFramework
+{
+    namespace Model
+    {
+        namespace BatchingQueue
+        {
+            // Bind the queue to a compiled Model and start the batching thread
+            BatchingQueue::BatchingQueue(std::shared_ptr<const Model> model, const uint32_t maxBatchSize, const std::chrono::microseconds maxWait) : 
+                mModelPtr(model), mContext(model, std::max<uint32_t>(maxBatchSize, 1U)), mMaxBatchSize(maxBatchSize), mMaxWait(maxWait), mStop(false), mLatencyIdx(0U)
+            {
+                if(NNFRAMEWORK_ZERO == mMaxBatchSize)
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Maximal batch size must be greater than zero!");
+                }
+
+                const auto& layers = mModelPtr->get_mLayers();
+
+                // preallocate micro-batch buffers for the largest micro-batch
+                mBatchInput = Matrix::Zero(mMaxBatchSize, layers[INPUT_LAYER_IDX]->get_mPerceptronNo());
+                mBatchOutput = Matrix::Zero(mMaxBatchSize, layers[OUTPUT_LAYER_IDX(layers.size())]->get_mPerceptronNo());
+                mBatch.reserve(mMaxBatchSize);
+                mLatenciesUs.reserve(LATENCY_SAMPLES_NO);
+
+                mBatchingThread = std::thread(&BatchingQueue::batchingLoop, this);
+            }
+
+            // Complete all waiting requests and stop the batching thread
+            BatchingQueue::~BatchingQueue()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mRequestsMutex);
+                    mStop = true;
+                }
+                mRequestsCv.notify_one();
+
+                mBatchingThread.join();
+            }
+
+            // Submit one input data row for prediction, result is returned trough the future
+            std::future<Vector> BatchingQueue::submit(const Eigen::Ref<const Vector>& inputRow)
+            {
+                Request request { inputRow, std::promise<Vector>(), nullptr, Clock::now() };
+                std::future<Vector> result = request.promise.get_future();
+
+                enqueue(std::move(request));
+
+                return result;
+            }
+
+            // Submit one input data row for prediction, result is returned trough the callback
+            void BatchingQueue::submit(const Eigen::Ref<const Vector>& inputRow, Callback callback)
+            {
+                enqueue(Request { inputRow, std::promise<Vector>(), std::move(callback), Clock::now() });
+            }
+
+            // Get statistics of the queue
+            BatchingStats BatchingQueue::get_mStats() const
+            {
+                std::lock_guard<std::mutex> lock(mStatsMutex);
+
+                BatchingStats stats = mStats;
+
+                // percentiles of the latest latencies
+                if(false == mLatenciesUs.empty())
+                {
+                    std::vector<double> latencies = mLatenciesUs;
+
+                    auto p50 = latencies.begin() + (latencies.size() / 2);
+                    std::nth_element(latencies.begin(), p50, latencies.end());
+                    stats.p50LatencyUs = *p50;
+
+                    auto p99 = latencies.begin() + ((latencies.size() * 99) / 100);
+                    std::nth_element(latencies.begin(), p99, latencies.end());
+                    stats.p99LatencyUs = *p99;
+                }
+
+                return stats;
+            }
+
+            // Add request to the queue and wake up the batching thread
+            void BatchingQueue::enqueue(Request&& request)
+            {
+                if(request.inputRow.size() != mBatchInput.cols())
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Input data row size does not match the number of perceptrons in the input layer!");
+                }
+
+                uint32_t queueDepth = 0U;
+
+                {
+                    std::lock_guard<std::mutex> lock(mRequestsMutex);
+                    mRequests.push_back(std::move(request));
+                    queueDepth = static_cast<uint32_t>(mRequests.size());
+                }
+                mRequestsCv.notify_one();
+
+                std::lock_guard<std::mutex> lock(mStatsMutex);
+                mStats.queueDepth = queueDepth;
+                mStats.maxQueueDepth = std::max(mStats.maxQueueDepth, queueDepth);
+            }
+
+            // Batching thread loop
+            void BatchingQueue::batchingLoop()
+            {
+                std::unique_lock<std::mutex> lock(mRequestsMutex);
+
+                while(true)
+                {
+                    // wait for the first request of the next micro-batch
+                    mRequestsCv.wait(lock, [this]() { return (true == mStop) || (false == mRequests.empty()); });
+
+                    if(true == mRequests.empty())
+                    {
+                        // stop requested and all requests are completed
+                        break;
+                    }
+
+                    // wait until micro-batch is full or the oldest request waited long enough
+                    // on stop, waiting requests are executed immediately
+                    const Clock::time_point deadline = mRequests.front().submitTime + mMaxWait;
+                    mRequestsCv.wait_until(lock, deadline, [this]() { return (true == mStop) || (mRequests.size() >= mMaxBatchSize); });
+
+                    // take up to mMaxBatchSize oldest requests
+                    const uint32_t batchRows = std::min<uint32_t>(mMaxBatchSize, mRequests.size());
+                    for (uint32_t i = 0; i < batchRows; ++i)
+                    {
+                        mBatch.push_back(std::move(mRequests.front()));
+                        mRequests.pop_front();
+                    }
+                    const uint32_t queueDepth = static_cast<uint32_t>(mRequests.size());
+
+                    // new requests can be submitted while the micro-batch is executed
+                    lock.unlock();
+
+                    runBatch();
+
+                    {
+                        std::lock_guard<std::mutex> statsLock(mStatsMutex);
+                        mStats.queueDepth = queueDepth;
+                    }
+
+                    lock.lock();
+                }
+            }
+
+            // Run one micro-batch trough the Model and complete all of its requests
+            void BatchingQueue::runBatch()
+            {
+                const uint32_t batchRows = static_cast<uint32_t>(mBatch.size());
+
+                // each request becomes one row of the micro-batch
+                for (uint32_t i = 0; i < batchRows; ++i)
+                {
+                    mBatchInput.row(i) = mBatch[i].inputRow.transpose();
+                }
+
+                // one batched forward pass for all requests, its failure is passed to every request of the micro-batch
+                std::exception_ptr error = nullptr;
+                try
+                {
+                    mContext.predictInto(mBatchInput.topRows(batchRows), mBatchOutput.topRows(batchRows));
+                }
+                catch(const std::exception& e)
+                {
+                    error = std::current_exception();
+
+                    std::cerr << __FUNCTION__ << ": ";
+                    std::cerr << e.what() << std::endl;
+                }
+
+                // each request is completed on its own, failing callback does not affect the other requests
+                uint32_t failedNo = 0U;
+                for (uint32_t i = 0; i < batchRows; ++i)
+                {
+                    if(false == completeRequest(mBatch[i], mBatchOutput.row(i).transpose(), error))
+                    {
+                        ++failedNo;
+                    }
+                }
+
+                const Clock::time_point completeTime = Clock::now();
+
+                // update statistics
+                {
+                    std::lock_guard<std::mutex> lock(mStatsMutex);
+
+                    for (uint32_t i = 0; i < batchRows; ++i)
+                    {
+                        const double latencyUs = std::chrono::duration<double, std::micro>(completeTime - mBatch[i].submitTime).count();
+
+                        if(mLatenciesUs.size() < LATENCY_SAMPLES_NO)
+                        {
+                            mLatenciesUs.push_back(latencyUs);
+                        }
+                        else
+                        {
+                            mLatenciesUs[mLatencyIdx] = latencyUs;
+                        }
+                        mLatencyIdx = (mLatencyIdx + 1U) % LATENCY_SAMPLES_NO;
+                    }
+
+                    mStats.requestsNo += batchRows;
+                    mStats.failedNo += failedNo;
+                    mStats.batchesNo += 1U;
+                    mStats.meanBatchSize = static_cast<double>(mStats.requestsNo) / static_cast<double>(mStats.batchesNo);
+                    mStats.maxBatchSize = std::max(mStats.maxBatchSize, batchRows);
+                }
+
+                mBatch.clear();
+            }
+
+            // Pass the predicted output row or the error to the caller
+            bool BatchingQueue::completeRequest(Request& request, const Eigen::Ref<const Vector>& outputRow, const std::exception_ptr& error)
+            {
+                if(nullptr == request.callback)
+                {
+                    if(nullptr == error)
+                    {
+                        request.promise.set_value(outputRow);
+                    }
+                    else
+                    {
+                        request.promise.set_exception(error);
+                    }
+
+                    return (nullptr == error);
+                }
+
+                // exception of the user callback stays with its request
+                try
+                {
+                    if(nullptr == error)
+                    {
+                        request.callback(outputRow, nullptr);
+                    }
+                    else
+                    {
+                        request.callback(Vector(), error);
+                    }
+                }
+                catch(const std::exception& e)
+                {
+                    std::cerr << __FUNCTION__ << ": ";
+                    std::cerr << e.what() << std::endl;
+
+                    return false;
+                }
+                catch(...)
+                {
+                    std::cerr << __FUNCTION__ << ": ";
+                    std::cerr << "Unknown exception thrown by the callback!" << std::endl;
+
+                    return false;
+                }
+
+                return (nullptr == error);
+            }
+        }
+    }
+}
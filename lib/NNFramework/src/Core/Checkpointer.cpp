@@ -0,0 +1,277 @@
+#include "Core/Checkpointer.hpp"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace NNFramework
+{
+    namespace Model
+    {
+        namespace Checkpointer
+        {
+            // Flush written file from the OS cache to the storage device
+            static void syncFile(const std::string& path)
+            {
+#ifdef _WIN32
+                HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+                bool synced = (INVALID_HANDLE_VALUE != file) && (0 != FlushFileBuffers(file));
+                if(INVALID_HANDLE_VALUE != file)
+                {
+                    CloseHandle(file);
+                }
+#else
+                int fd = open(path.c_str(), O_RDONLY);
+                bool synced = (-1 != fd) && (0 == fsync(fd));
+                if(-1 != fd)
+                {
+                    close(fd);
+                }
+#endif
+                if(false == synced)
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("File " + path + " cannot be synchronized to the storage!");
+                }
+            }
+
+            // Bind checkpointer to the Model, checkpoints are written into checkpointPath
+            Checkpointer::Checkpointer(const Model& model, const std::string checkpointPath, const uint32_t everyEpochs, 
+                                       const std::chrono::seconds everySeconds, const bool incremental, const uint32_t blockSize) : 
+                everyEpochs(everyEpochs), everySeconds(everySeconds), incremental(incremental), blockSize(blockSize), 
+                mModel(model), mCheckpointPath(checkpointPath), mHasWritten(false), mLastCheckpoint(std::chrono::steady_clock::now()),
+                mSnapshotReady(false), mWritingActive(false), mStop(false), mWrittenNo(0U), mFailedNo(0U), mReplacedNo(0U), mWrittenBlocksNo(0U)
+            {
+                if(NNFRAMEWORK_ZERO == blockSize)
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Block size must be greater than zero!");
+                }
+
+                mCheckpointThread = std::thread(&Checkpointer::checkpointLoop, this);
+            }
+
+            // Write the waiting checkpoint and stop the checkpoint thread
+            Checkpointer::~Checkpointer()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    mStop = true;
+                }
+                mCv.notify_all();
+
+                mCheckpointThread.join();
+            }
+
+            void Checkpointer::onBatchEnd(const Callbacks::TrainingState&)
+            {
+                if((everySeconds.count() > 0) && ((std::chrono::steady_clock::now() - mLastCheckpoint) >= everySeconds))
+                {
+                    takeSnapshot();
+                }
+            }
+
+            void Checkpointer::onEpochEnd(const Callbacks::TrainingState& state)
+            {
+                const bool epochDue = (NNFRAMEWORK_ZERO != everyEpochs) && (NNFRAMEWORK_ZERO == ((state.epoch + 1U) % everyEpochs));
+                const bool timeDue = (everySeconds.count() > 0) && ((std::chrono::steady_clock::now() - mLastCheckpoint) >= everySeconds);
+
+                if((true == epochDue) || (true == timeDue))
+                {
+                    takeSnapshot();
+                }
+            }
+
+            void Checkpointer::onTrainEnd(const Callbacks::TrainingState&)
+            {
+                takeSnapshot();
+                flush();
+            }
+
+            // Wait until the waiting checkpoint is written
+            void Checkpointer::flush()
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCv.wait(lock, [this]() { return (false == mSnapshotReady) && (false == mWritingActive); });
+            }
+
+            uint64_t Checkpointer::get_mWrittenNo() const
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                return mWrittenNo;
+            }
+
+            uint64_t Checkpointer::get_mFailedNo() const
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                return mFailedNo;
+            }
+
+            std::string Checkpointer::get_mLastError() const
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                return mLastError;
+            }
+
+            uint64_t Checkpointer::get_mReplacedNo() const
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                return mReplacedNo;
+            }
+
+            uint64_t Checkpointer::get_mWrittenBlocksNo() const
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                return mWrittenBlocksNo;
+            }
+
+            // Copy current Model parameters into the snapshot buffer and wake up the checkpoint thread
+            void Checkpointer::takeSnapshot()
+            {
+                mLastCheckpoint = std::chrono::steady_clock::now();
+
+                {
+                    // checkpoint thread only touches mSnapshot while swapping the buffers
+                    std::lock_guard<std::mutex> lock(mMutex);
+
+                    if(true == mSnapshotReady)
+                    {
+                        ++mReplacedNo;
+                    }
+
+                    mSnapshot = mModel.get_mParameters();
+                    mSnapshotReady = true;
+                }
+                mCv.notify_all();
+            }
+
+            // Checkpoint thread loop
+            void Checkpointer::checkpointLoop()
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+
+                while(true)
+                {
+                    mCv.wait(lock, [this]() { return (true == mStop) || (true == mSnapshotReady); });
+
+                    if(false == mSnapshotReady)
+                    {
+                        // stop requested and all snapshots are written
+                        break;
+                    }
+
+                    // take the snapshot, training thread can fill the snapshot buffer again
+                    mWriting.swap(mSnapshot);
+                    mSnapshotReady = false;
+                    mWritingActive = true;
+                    lock.unlock();
+
+                    // failed checkpoint is reported and training continues, the next checkpoint is written as usual
+                    std::string error;
+                    try
+                    {
+                        if((true == incremental) && (true == mHasWritten) && (mWritten.size() == mWriting.size()))
+                        {
+                            writeIncremental();
+                        }
+                        else
+                        {
+                            writeFull();
+                        }
+
+                        // keep written parameters for the next incremental checkpoint
+                        if(true == incremental)
+                        {
+                            mWritten.swap(mWriting);
+                            mHasWritten = true;
+                        }
+                    }
+                    catch(const std::exception& e)
+                    {
+                        std::cerr << __FUNCTION__ << ": ";
+                        std::cerr << e.what() << std::endl;
+                        error = e.what();
+                    }
+
+                    lock.lock();
+                    mWritingActive = false;
+                    if(true == error.empty())
+                    {
+                        ++mWrittenNo;
+                    }
+                    else
+                    {
+                        ++mFailedNo;
+                        mLastError = error;
+                    }
+                    mCv.notify_all();
+                }
+            }
+
+            // Write whole model file into a temporary file and replace the checkpoint with it
+            void Checkpointer::writeFull()
+            {
+                const std::string tmpPath = mCheckpointPath + ".tmp";
+
+                if(false == mModel.saveModel(tmpPath, mWriting))
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Checkpoint " + tmpPath + " cannot be written!");
+                }
+
+                syncFile(tmpPath);
+
+                // readers always see either the previous or the new complete checkpoint
+                std::filesystem::rename(tmpPath, mCheckpointPath);
+            }
+
+            // Rewrite changed blocks of parameters in the existing checkpoint
+            void Checkpointer::writeIncremental()
+            {
+                std::fstream checkpointFile(mCheckpointPath, std::ios::in | std::ios::out | std::ios::binary);
+                if(false == checkpointFile.is_open())
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Checkpoint " + mCheckpointPath + " cannot be opened!");
+                }
+
+                const uint64_t parametersOffset = ModelFile::parametersOffset(mModel.get_mLayersNo());
+                const Eigen::Index parametersNo = mWriting.size();
+                uint64_t writtenBlocksNo = 0U;
+
+                for(Eigen::Index blockIdx = 0; blockIdx < parametersNo; blockIdx += blockSize)
+                {
+                    const Eigen::Index blockRows = std::min<Eigen::Index>(blockSize, parametersNo - blockIdx);
+
+                    if(mWriting.segment(blockIdx, blockRows) != mWritten.segment(blockIdx, blockRows))
+                    {
+                        checkpointFile.seekp(static_cast<std::streamoff>(parametersOffset + (blockIdx * sizeof(Scalar))));
+                        checkpointFile.write(reinterpret_cast<const char*>(mWriting.data() + blockIdx), static_cast<std::streamsize>(blockRows * sizeof(Scalar)));
+                        ++writtenBlocksNo;
+                    }
+                }
+
+                checkpointFile.close();
+                if(true == checkpointFile.fail())
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Checkpoint " + mCheckpointPath + " cannot be written!");
+                }
+
+                syncFile(mCheckpointPath);
+
+                std::lock_guard<std::mutex> lock(mMutex);
+                mWrittenBlocksNo += writtenBlocksNo;
+            }
+        }
+    }
+}
@@ -0,0 +1,36 @@
+#include "Core/InferenceContext.hpp"
+#include <iostream>
+
+namespace NNFramework
+{
+    namespace Model
+    {
+        namespace InferenceContext
+        {
+            // Bind the context to a compiled Model
+            InferenceContext::InferenceContext(std::shared_ptr<const Model> model, const uint32_t tileRows) : mModelPtr(std::move(model))
+            {
+                if((nullptr == mModelPtr) || (false == mModelPtr->get_mIsCompiled()))
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Model is not compiled!");
+                }
+
+                if(NNFRAMEWORK_ZERO == tileRows)
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Number of tile rows must be greater than zero!");
+                }
+
+                // forward pass only Workspace, backpropagation buffers are never used trough the context
+                mWorkspacePtr = std::make_unique<Workspace::Workspace>(mModelPtr->get_mLayers(), tileRows);
+            }
+
+            // Trained model predict on provided input data, predictions are written into predictedData
+            void InferenceContext::predictInto(const Eigen::Ref<const Matrix>& inputData, Eigen::Ref<Matrix> predictedData)
+            {
+                mModelPtr->modelPredict(*mWorkspacePtr, inputData, predictedData);
+            }
+        }
+    }
+}
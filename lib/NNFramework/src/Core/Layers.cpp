@@ -1,38 +1,50 @@
 #include "Core/Layers.hpp"
+#include <new>
 
 namespace NNFramework
 {
     namespace Layers
     {
-        Layer::Layer(const uint8_t perceptronNo) : mLayerId(0), mPerceptronNo(perceptronNo), mLearnableCoeffs(0)
+        Layer::Layer(const uint8_t perceptronNo) : mLayerWeights(nullptr, 0, 0), mLayerBias(nullptr, 0, 0), 
+                                                   mLayerWGradients(nullptr, 0, 0), mLayerBGradients(nullptr, 0, 0),
+                                                   mLayerId(0), mPerceptronNo(perceptronNo), mLearnableCoeffs(0)
         {
-            mLayerWeights = std::make_shared<Eigen::MatrixXd>();
-            mLayerZ = std::make_shared<Eigen::MatrixXd>();
-            mLayerBias = std::make_shared<Eigen::MatrixXd>();
-            mLayerZActivated = std::make_shared<Eigen::MatrixXd>();
-            mLayerWGradients = std::make_shared<Eigen::MatrixXd>();
-            mLayerBGradients = std::make_shared<Eigen::MatrixXd>();
             // This way we are sure we are having "Passtrough" activation for the input layer 
             // and as this constructor is protected only classes that are inheriting Layers::Layer
             // can construct base functionality of the Layer class
             mActivationPtr = std::make_unique<Activations::InputActivation>(); 
         }
 
-        Layer::Layer(Layer&& l) : mLayerId(l.mLayerId), mPerceptronNo(l.mPerceptronNo), mLearnableCoeffs(l.mLearnableCoeffs)
+        Layer::Layer(Layer&& l) : mLayerWeights(l.mLayerWeights), mLayerBias(l.mLayerBias), 
+                                  mLayerWGradients(l.mLayerWGradients), mLayerBGradients(l.mLayerBGradients),
+                                  mLayerId(l.mLayerId), mPerceptronNo(l.mPerceptronNo), mLearnableCoeffs(l.mLearnableCoeffs)
         {
-            mLayerWeights = std::move(l.mLayerWeights);
-            mLayerZ = std::move(l.mLayerZ);
-            mLayerBias = std::move(l.mLayerBias);
-            mLayerZActivated = std::move(l.mLayerZActivated);
-            mLayerWGradients = std::move(l.mLayerWGradients);
-            mLayerBGradients = std::move(l.mLayerBGradients);
             mActivationPtr = std::move(l.mActivationPtr);
+
+            // moved from layer does not view the Model buffers anymore
+            l.set_mParameters(nullptr, 0, 0);
+            l.set_mGradients(nullptr, 0, 0);
             
             l.mLayerId = 0;
             l.mPerceptronNo = 0;
             l.mLearnableCoeffs = 0;
         }
 
+        // Bind layer Weights and Bias to the Model parameters buffer
+        void Layer::set_mParameters(Scalar* parameters, const Eigen::Index rows, const Eigen::Index cols)
+        {
+            // placement new is the Eigen way of changing the array an Eigen::Map is viewing
+            new (&mLayerWeights) Eigen::Map<Matrix>(parameters, rows, cols);
+            new (&mLayerBias) Eigen::Map<Matrix>(parameters + (rows * cols), rows, MATRIX_COL_INIT_VAL);
+        }
+
+        // Bind layer Weights and Bias gradients to the Model gradients buffer
+        void Layer::set_mGradients(Scalar* gradients, const Eigen::Index rows, const Eigen::Index cols)
+        {
+            new (&mLayerWGradients) Eigen::Map<Matrix>(gradients, rows, cols);
+            new (&mLayerBGradients) Eigen::Map<Matrix>(gradients + (rows * cols), rows, MATRIX_COL_INIT_VAL);
+        }
+
         Dense::Dense(const uint8_t perceptronNo) : Layer(perceptronNo)
         {
             ++mInstances;
@@ -1,6 +1,11 @@
 #include "Core/Model.hpp"
 #include <iostream>
 #include <string>
+#include <thread>
+#include <fstream>
+#include <cstring>
+#include <new>
+#include <limits>
 
 namespace NNFramework
 {
@@ -37,19 +42,92 @@ namespace NNFramework
             // initialize all layers coefficients
             initializeLayers();
 
+            // allocate Workspaces used by forward pass and backpropagation
+            initializeWorkspaces();
+
             // set model compiled 
             mIsCompiled = true;
 
             return this->mIsCompiled;
         }
 
-        // Save model weights to desired location
+        // Save model topology, activations and weights to desired location
         bool Model::saveModel(std::string modelPath) const
+        {
+            return saveModel(modelPath, mParameters);
+        }
+
+        // Save model topology and activations with the provided Weights and Biases
+        bool Model::saveModel(std::string modelPath, const Eigen::Ref<const Vector>& parameters) const
         {
             try
             {
-                /* Not supported in this version of NNFramework */
-                return false;
+                // loaded model holds its weights even before it is compiled
+                if(false == mIsLoaded)
+                {
+                    checkIsModelCompiled(__FUNCTION__);
+                }
+
+                if(parameters.size() != getParametersNo())
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Number of parameters does not match the model!");
+                }
+
+                // activation names are stored zero terminated, a truncated name could not be loaded
+                for(auto it = mLayers.begin(); it != mLayers.end(); ++it)
+                {
+                    if((*it)->mActivationPtr->name().size() >= ModelFile::ACTIVATION_NAME_SIZE)
+                    {
+                        std::cout << __FUNCTION__ << ": ";
+                        throw std::runtime_error("Activation name " + (*it)->mActivationPtr->name() + " does not fit into the model file!");
+                    }
+                }
+
+                std::ofstream modelFile(modelPath, std::ios::out | std::ios::binary | std::ios::trunc);
+                if(false == modelFile.is_open())
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Model file " + modelPath + " cannot be created!");
+                }
+
+                // header
+                ModelFile::Header header {};
+                std::memcpy(header.magic, ModelFile::MAGIC, sizeof(header.magic));
+                header.version = ModelFile::VERSION;
+                header.scalarSize = sizeof(Scalar);
+                header.layersNo = mLayersNo;
+                header.parametersNo = static_cast<uint64_t>(parameters.size());
+                header.parametersOffset = ModelFile::parametersOffset(mLayersNo);
+
+                modelFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+                // topology and activation of each layer
+                for(auto it = mLayers.begin(); it != mLayers.end(); ++it)
+                {
+                    ModelFile::LayerRecord record {};
+                    record.perceptronNo = (*it)->get_mPerceptronNo();
+                    std::strncpy(record.activation, (*it)->mActivationPtr->name().c_str(), ModelFile::ACTIVATION_NAME_SIZE - 1U);
+
+                    modelFile.write(reinterpret_cast<const char*>(&record), sizeof(record));
+                }
+
+                // pad up to the aligned parameters blob
+                const uint64_t recordsEnd = sizeof(header) + (static_cast<uint64_t>(mLayersNo) * sizeof(ModelFile::LayerRecord));
+                const char padding[ModelFile::PARAMETERS_ALIGNMENT] = {};
+                modelFile.write(padding, static_cast<std::streamsize>(header.parametersOffset - recordsEnd));
+
+                // raw Weights and Biases of all layers
+                modelFile.write(reinterpret_cast<const char*>(parameters.data()), static_cast<std::streamsize>(parameters.size() * sizeof(Scalar)));
+
+                modelFile.flush();
+                if(false == modelFile.good())
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Model file " + modelPath + " cannot be written!");
+                }
+
+                return true;
             }
             catch(const std::exception& e)
             {
@@ -60,13 +138,129 @@ namespace NNFramework
 
         }
 
-        // Load model weights from desired location
-        bool Model::loadModel()
+        // Load model topology, activations and weights from desired location
+        bool Model::loadModel(std::string modelPath)
         {
             try
             {
-                /* Not supported in this version of NNFramework */
-                return false;
+                // copy-on-write mapping, so the loaded model can continue training
+                std::unique_ptr<MappedFile::MappedFile> modelFilePtr = std::make_unique<MappedFile::MappedFile>(modelPath, MappedFile::MapMode::COPY_ON_WRITE);
+
+                // validate whole file before the model is modified
+                ModelFile::Header header {};
+                if(modelFilePtr->size() < sizeof(header))
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Model file " + modelPath + " is too short!");
+                }
+                std::memcpy(&header, modelFilePtr->data(), sizeof(header));
+
+                if((0 != std::memcmp(header.magic, ModelFile::MAGIC, sizeof(header.magic))) || (ModelFile::VERSION != header.version))
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("File " + modelPath + " is not a supported NNFramework model file!");
+                }
+
+                // model has at least the input and the output layer
+                // parametersNo is compared with the number of scalars which fit behind parametersOffset, thus the size cannot overflow
+                if(((sizeof(float) != header.scalarSize) && (sizeof(double) != header.scalarSize)) || 
+                   (header.layersNo < 2U) ||
+                   (header.parametersOffset != ModelFile::parametersOffset(header.layersNo)) ||
+                   (modelFilePtr->size() < header.parametersOffset) ||
+                   (header.parametersNo > ((modelFilePtr->size() - header.parametersOffset) / header.scalarSize)))
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Model file " + modelPath + " is corrupted!");
+                }
+
+                std::vector<ModelFile::LayerRecord> records(header.layersNo);
+                std::memcpy(records.data(), modelFilePtr->data() + sizeof(header), header.layersNo * sizeof(ModelFile::LayerRecord));
+
+                // number of Weights and Biases described by the layer records has to match the parameters blob
+                uint64_t parametersNo = 0U;
+                for(uint32_t i = 0; i < header.layersNo; ++i)
+                {
+                    records[i].activation[ModelFile::ACTIVATION_NAME_SIZE - 1U] = '\0';
+
+                    if((NNFRAMEWORK_ZERO == records[i].perceptronNo) || (records[i].perceptronNo > std::numeric_limits<uint8_t>::max()))
+                    {
+                        std::cout << __FUNCTION__ << ": ";
+                        throw std::runtime_error("Model file " + modelPath + " is corrupted!");
+                    }
+
+                    if(INPUT_LAYER_IDX != i)
+                    {
+                        parametersNo += static_cast<uint64_t>(records[i].perceptronNo) * (records[PREVIOUS_LAYER_IDX(i)].perceptronNo + 1U);
+                    }
+                }
+
+                if(parametersNo != header.parametersNo)
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Model file " + modelPath + " is corrupted!");
+                }
+
+                // layers already added to the model have to match the model file
+                if(NNFRAMEWORK_ZERO != mLayersNo)
+                {
+                    bool matching = (mLayersNo == header.layersNo);
+                    for(uint32_t i = 0; (true == matching) && (i < mLayersNo); ++i)
+                    {
+                        matching = (mLayers[i]->get_mPerceptronNo() == records[i].perceptronNo) && 
+                                   (mLayers[i]->mActivationPtr->name() == records[i].activation);
+                    }
+
+                    if(false == matching)
+                    {
+                        std::cout << __FUNCTION__ << ": ";
+                        throw std::runtime_error("Model layers do not match the model file " + modelPath + "!");
+                    }
+                }
+                else
+                {
+                    // create activations first, unknown activation leaves the model untouched
+                    std::vector<std::unique_ptr<Activations::ActivationFunctor>> activations;
+                    for(uint32_t i = 0; i < header.layersNo; ++i)
+                    {
+                        activations.push_back(Activations::makeActivation(records[i].activation));
+                    }
+
+                    // create layers from the model file
+                    for(uint32_t i = 0; i < header.layersNo; ++i)
+                    {
+                        addLayer(Layers::Dense(static_cast<uint8_t>(records[i].perceptronNo), std::move(activations[i])));
+                    }
+                }
+
+                uint8_t* blob = modelFilePtr->data() + header.parametersOffset;
+
+                if(sizeof(Scalar) == header.scalarSize)
+                {
+                    // use mapped Weights and Biases in place
+                    new (&mParameters) Eigen::Map<Vector>(reinterpret_cast<Scalar*>(blob), header.parametersNo);
+                    mMappedFilePtr = std::move(modelFilePtr);
+                    mParametersStorage.resize(0);
+                }
+                else if(sizeof(float) == header.scalarSize)
+                {
+                    // model saved by the build with a different Scalar type has to be converted
+                    mParametersStorage = Eigen::Map<const Eigen::VectorXf>(reinterpret_cast<const float*>(blob), header.parametersNo).cast<Scalar>();
+                    new (&mParameters) Eigen::Map<Vector>(mParametersStorage.data(), mParametersStorage.size());
+                    mMappedFilePtr.reset();
+                }
+                else
+                {
+                    mParametersStorage = Eigen::Map<const Eigen::VectorXd>(reinterpret_cast<const double*>(blob), header.parametersNo).cast<Scalar>();
+                    new (&mParameters) Eigen::Map<Vector>(mParametersStorage.data(), mParametersStorage.size());
+                    mMappedFilePtr.reset();
+                }
+
+                mIsLoaded = true;
+
+                // layers view the loaded parameters right away, thus a loaded model can be saved or folded before it is compiled
+                bindLayers();
+
+                return true;
             }
             catch(const std::exception& e)
             {
@@ -77,7 +271,7 @@ namespace NNFramework
         }
 
         // Train compiled model
-        void Model::modelFit(const Eigen::MatrixXd& inData, const Eigen::MatrixXd& expData, const uint16_t epochs)
+        void Model::modelFit(const Matrix& inData, const Matrix& expData, const uint16_t epochs)
         {
             // check if model is compiled
             checkIsModelCompiled(__FUNCTION__);
@@ -89,73 +283,504 @@ namespace NNFramework
             // check if input data and expected data have same number of rows
             checkInExpRowDim(__FUNCTION__, inData, expData);
 
-            // check if input data has the same number of columns as number of rows in input layer of NN
-            // check if expectedData has the same number of columns as number of rows in output layer of NN
-            checkRowColDim(__FUNCTION__, inData, *(mLayers[INPUT_LAYER_IDX]->get_mLayerZActivated()));
-            checkRowColDim(__FUNCTION__, expData, *(mLayers[OUTPUT_LAYER_IDX(mLayersNo)]->get_mLayerZActivated()));
+            // data rows are read trough the shuffled row indices, data is not copied
+            DataSource::MatrixDataSource dataSource(inData, expData);
+
+            modelFit(dataSource, epochs);
+        }
+
+        // Train desired model on the selected columns of the dataset
+        void Model::modelFit(const Dataset::Dataset& dataset, const std::vector<std::string>& inColumns, const std::vector<std::string>& expColumns, const uint16_t epochs)
+        {
+            // check if model is compiled
+            checkIsModelCompiled(__FUNCTION__);
+
+            // selected columns are read from the mapped shards block by block
+            DataSource::DatasetDataSource dataSource(dataset, inColumns, expColumns);
+
+            modelFit(dataSource, epochs);
+        }
+
+        // Train desired model on the data rows taken from the data source
+        void Model::modelFit(DataSource::DataSource& dataSource, const uint16_t epochs)
+        {
+            // check if model is compiled
+            checkIsModelCompiled(__FUNCTION__);
+
+            // check if configured batch size is valid
+            checkBatchSize(__FUNCTION__);
+
+            // check if data rows of the data source match the input and output layer of NN
+            checkDataSourceDim(__FUNCTION__, dataSource);
+
+            // check if configured number of threads is valid
+            checkThreadsNo(__FUNCTION__);
 
             // Configure the rest of the model in "train-time"
 
-            // Data handler reference used for shuffling the data
-            std::unique_ptr<DataHandler::DataHandler>& mDataHandlerRef = DataHandler::DataHandler::getInstance(); 
+            // allocate history buffers for all epochs in advance
+            mHistory.hLoss.resize(epochs);
+            mHistory.hAccuracy.resize(epochs);
+            mHistory.hShuffleTime.setZero(epochs);
+            mHistory.hDataTime.setZero(epochs);
+            mHistory.hForwardTime.setZero(epochs);
+            mHistory.hLossTime.setZero(epochs);
+            mHistory.hBackpropTime.setZero(epochs);
+            mHistory.hReduceTime.setZero(epochs);
+            mHistory.hOptimizerTime.setZero(epochs);
+            mHistory.hEpochTime.setZero(epochs);
+            mHistory.hSamplesPerSec.setZero(epochs);
+
+            // each batch is split across all configured threads
+            // all threads meet at the synchronization point after each training step
+            // in Hogwild mode threads meet only at the beginning and at the end of each epoch
+            const uint16_t threadsNo = mModelConfigPtr->mThreadsNo;
+            const bool hogwild = (mModelConfigPtr->mHogwild) && (threadsNo > 1U);
+            std::barrier<> syncPoint(threadsNo);
+
+            // batches are prepared ahead by the prefetching data source if configured
+            std::unique_ptr<DataSource::PrefetchDataSource> prefetchSource;
+            if (NNFRAMEWORK_ZERO != mModelConfigPtr->mPrefetchDepth)
+            {
+                prefetchSource = std::make_unique<DataSource::PrefetchDataSource>(dataSource, mModelConfigPtr->mPrefetchDepth);
+            }
+            TrainingData trainingData((nullptr != prefetchSource) ? static_cast<DataSource::DataSource&>(*prefetchSource) : dataSource);
+
+            // training loop of one thread
+            // exception thrown by any of the threads (data source, callbacks) aborts the training of all threads
+            auto trainingThread = [&](const uint16_t threadIdx)
+            {
+                try
+                {
+                    if (true == hogwild)
+                    {
+                        fitHogwildThread(threadIdx, syncPoint, trainingData, epochs);
+                    }
+                    else
+                    {
+                        fitThread(threadIdx, syncPoint, trainingData, epochs);
+                    }
+                }
+                catch (...)
+                {
+                    abortTraining(syncPoint, trainingData, std::current_exception());
+                }
+            };
+
+            // start additional threads, calling thread acts as the first thread
+            std::vector<std::jthread> threads;
+            for (uint16_t threadIdx = 1; threadIdx < threadsNo; ++threadIdx)
+            {
+                threads.emplace_back(trainingThread, threadIdx);
+            }
+
+            trainingThread(0U);
 
-            // construct new matrices for data shuffle between epoch
-            // more memory consumption, less error prone (moral dilema?)
-            Eigen::MatrixXd inputData = inData;
-            Eigen::MatrixXd expectedData = expData;
+            // wait for all threads to finish
+            threads.clear();
+
+            // exception of the aborted training is thrown on the calling thread
+            if (nullptr != trainingData.error)
+            {
+                std::rethrow_exception(trainingData.error);
+            }
+
+            // notify training observers
+            if ((false == mModelConfigPtr->mCallbacks.empty()) && (NNFRAMEWORK_ZERO != epochs))
+            {
+                const uint32_t lastEpoch = epochs - 1U;
+                const uint32_t rowsNo = trainingData.epochRows.load();
+                const Callbacks::TrainingState state { lastEpoch, epochs, getLastBatchIdx(rowsNo), rowsNo, rowsNo, mHistory.hLoss[lastEpoch], static_cast<double>(mHistory.hAccuracy[lastEpoch]) };
+                for (const auto& callback : mModelConfigPtr->mCallbacks)
+                {
+                    callback->onTrainEnd(state);
+                }
+            }
+        }
+
+        // Training loop of one thread
+        void Model::fitThread(const uint16_t threadIdx, std::barrier<>& syncPoint, TrainingData& trainingData, const uint16_t epochs)
+        {
+            // number of data rows propagated trough the NNetwork before each optimizer step
+            const uint32_t batchSize = mModelConfigPtr->mBatchSize;
+            const uint16_t threadsNo = mModelConfigPtr->mThreadsNo;
+
+            // all intermediate results of this thread are stored in its own preallocated Workspace
+            // batches are taken into the Workspace of the first thread, the rest of the threads copy their shard of the batch
+            Workspace::Workspace& workspace = *mWorkspaces[threadIdx];
+            Workspace::Workspace& batchWorkspace = *mWorkspaces[0];
+
+            // training observers, notified by the first thread
+            const std::vector<std::shared_ptr<Callbacks::CallbackFunctor>>& callbacks = mModelConfigPtr->mCallbacks;
+
+            // training phases are measured by the first thread only
+            PhaseTimer timer;
+            timer.enabled = (true == mModelConfigPtr->mProfiling) && (0U == threadIdx);
 
             // For provided number of epochs train the model
             for (uint32_t ep = 0; ep < epochs; ++ep)
             {
+                const std::chrono::steady_clock::time_point epochStart = std::chrono::steady_clock::now();
+                timer.times.fill(0.0);
+                timer.begin();
+
                 // shuffle training data for better problem generalization
-                if (true == (mModelConfigPtr->mShuffleData->mShuffleOnFit))
+                // first thread starts the epoch of the data source, the rest waits for it to finish
+                if (0U == threadIdx)
                 {
-                    if (NNFRAMEWORK_ZERO == (ep % mModelConfigPtr->mShuffleData->mShuffleStep))
+                    trainingData.source.reset(isShuffleEpoch(ep));
+                    trainingData.epochRows.store(0U, std::memory_order_relaxed);
+                }
+                if (false == synchronizeThreads(syncPoint, trainingData))
+                {
+                    return;
+                }
+                timer.end(SHUFFLE_PHASE);
+
+                // reset loss and metrics
+                workspace.mEpochLoss.setZero();
+                workspace.mEpochMetrics = 0.0;
+
+                // for each batch of data rows taken from the data source
+                for (uint32_t batchIdx = 0; ; ++batchIdx)
+                {
+                    // first thread takes the next batch, each data row becomes one column of the input layer and expected output
+                    if (0U == threadIdx)
+                    {
+                        trainingData.batchRows.store(trainingData.source.nextBatch(batchWorkspace.mLayerZActivated[INPUT_LAYER_IDX].leftCols(batchSize), 
+                                                                                   batchWorkspace.mExpected.leftCols(batchSize)), std::memory_order_relaxed);
+                    }
+                    if (false == synchronizeThreads(syncPoint, trainingData))
                     {
-                        mDataHandlerRef->shuffleData(inputData, expectedData);
+                        return;
                     }
+                    timer.end(DATA_PHASE);
+
+                    // last batch of the epoch can be smaller than the configured batch size
+                    const uint32_t batchRows = trainingData.batchRows.load(std::memory_order_relaxed);
+                    if (NNFRAMEWORK_ZERO == batchRows)
+                    {
+                        break;
+                    }
+
+                    // rows of the batch handled by this thread
+                    const uint32_t shardSize = (batchRows + threadsNo - 1) / threadsNo;
+                    const uint32_t shardIdx = std::min<uint32_t>(threadIdx * shardSize, batchRows);
+                    const uint32_t shardRows = std::min<uint32_t>(shardSize, batchRows - shardIdx);
+
+                    if (NNFRAMEWORK_ZERO != shardRows)
+                    {
+                        // shard of the first thread is already in place, the batch is only read until the next batch is taken
+                        if (0U != threadIdx)
+                        {
+                            workspace.mLayerZActivated[INPUT_LAYER_IDX].leftCols(shardRows) = batchWorkspace.mLayerZActivated[INPUT_LAYER_IDX].middleCols(shardIdx, shardRows);
+                            workspace.mExpected.leftCols(shardRows) = batchWorkspace.mExpected.middleCols(shardIdx, shardRows);
+                        }
+
+                        // forward pass trough NNetwork
+                        timer.begin();
+                        forwardPass(workspace, shardRows, true);
+                        timer.end(FORWARD_PHASE);
+                        
+                        // calculate losses and metrics
+                        workspace.mEpochMetrics += calculateLossAndMetrics(workspace, shardRows, workspace.mEpochLoss);
+                        timer.end(LOSS_PHASE);
+
+                        // backpropagation trough the NNetwork
+                        // gradients of all shards are averaged over the whole batch
+                        backPropagation(workspace, shardRows, static_cast<Scalar>(1.0) / static_cast<Scalar>(batchRows));
+                        timer.end(BACKPROP_PHASE);
+                    }
+                    else
+                    {
+                        // batch is smaller than the number of threads, this thread does not contribute to the gradients
+                        workspace.mGradients.setZero();
+                        timer.begin();
+                    }
+                    if (false == synchronizeThreads(syncPoint, trainingData))
+                    {
+                        return;
+                    }
+
+                    // reduce gradients of all threads into the gradients of the first thread
+                    // pairwise tree reduction, each level halves the number of gradient buffers
+                    for (uint16_t stride = 1; stride < threadsNo; stride *= 2)
+                    {
+                        if ((NNFRAMEWORK_ZERO == (threadIdx % (2 * stride))) && ((threadIdx + stride) < threadsNo))
+                        {
+                            workspace.mGradients += mWorkspaces[threadIdx + stride]->mGradients;
+                        }
+                        if (false == synchronizeThreads(syncPoint, trainingData))
+                        {
+                            return;
+                        }
+                    }
+                    timer.end(REDUCE_PHASE);
+
+                    if (0U == threadIdx)
+                    {
+                        // update layer coefficients based on backpropagation gradient calculation
+                        ((*mModelConfigPtr->mOptimizerPtr))(mParameters, workspace.mGradients);
+                        timer.end(OPTIMIZER_PHASE);
+
+                        const uint32_t rowsDone = trainingData.epochRows.fetch_add(batchRows, std::memory_order_relaxed) + batchRows;
+
+                        // notify training observers
+                        if (false == callbacks.empty())
+                        {
+                            const Callbacks::TrainingState state = getTrainingState(ep, epochs, batchIdx, rowsDone, static_cast<uint32_t>(trainingData.source.rowsNo()));
+                            for (const auto& callback : callbacks)
+                            {
+                                callback->onBatchEnd(state);
+                            }
+                        }
+                    }
+
+                    // parameters have to be updated before the next forward pass
+                    if (false == synchronizeThreads(syncPoint, trainingData))
+                    {
+                        return;
+                    }
+                }
+
+                if (0U == threadIdx)
+                {
+                    // save loss and metrics of each epoh
+                    saveEpochResults(ep, std::chrono::duration<double>(std::chrono::steady_clock::now() - epochStart).count(), trainingData.epochRows.load(), timer);
+
+                    // notify training observers
+                    notifyEpochEnd(ep, epochs, trainingData.epochRows.load());
                 }
+            }
+        }
+
+        // Asynchronous (Hogwild) training loop of one thread
+        void Model::fitHogwildThread(const uint16_t threadIdx, std::barrier<>& syncPoint, TrainingData& trainingData, const uint16_t epochs)
+        {
+            // number of data rows propagated trough the NNetwork before each optimizer step of this thread
+            const uint32_t batchSize = mModelConfigPtr->mBatchSize;
+
+            // all intermediate results and gradients of this thread are stored in its own preallocated Workspace
+            Workspace::Workspace& workspace = *mWorkspaces[threadIdx];
 
-                // loss and metrics
-                Eigen::VectorXd loss = Eigen::VectorXd::Zero(expectedData.cols());
-                double metrics;
-                
-                std::tuple<Eigen::VectorXd, double> lossAndMetrics;
+            // training phases are measured by the first thread only
+            PhaseTimer timer;
+            timer.enabled = (true == mModelConfigPtr->mProfiling) && (0U == threadIdx);
 
-                // for each data row in inputData
-                for (uint32_t rowIdx = 0; rowIdx < inputData.rows(); ++rowIdx)
+            // For provided number of epochs train the model
+            for (uint32_t ep = 0; ep < epochs; ++ep)
+            {
+                const std::chrono::steady_clock::time_point epochStart = std::chrono::steady_clock::now();
+                timer.times.fill(0.0);
+                timer.begin();
+
+                // shuffle training data for better problem generalization
+                // first thread starts the epoch of the data source, the rest waits for it to finish
+                if (0U == threadIdx)
                 {
-                    // forward pass trough NNetwork
-                    forwardPass(inputData, rowIdx);
-                    
+                    trainingData.source.reset(isShuffleEpoch(ep));
+                    trainingData.epochRows.store(0U, std::memory_order_relaxed);
+                }
+                if (false == synchronizeThreads(syncPoint, trainingData))
+                {
+                    return;
+                }
+                timer.end(SHUFFLE_PHASE);
+
+                // reset loss and metrics
+                workspace.mEpochLoss.setZero();
+                workspace.mEpochMetrics = 0.0;
+
+                // take next batch of data rows from the shared data source until the end of the epoch
+                // or until the training is aborted by one of the threads
+                while (false == trainingData.aborted.load(std::memory_order_relaxed))
+                {
+                    // each data row of the batch becomes one column of the input layer and expected output
+                    // threads take their batches one at a time, data source is not thread safe
+                    uint32_t batchRows;
+                    {
+                        std::lock_guard<std::mutex> lock(trainingData.sourceMutex);
+                        batchRows = trainingData.source.nextBatch(workspace.mLayerZActivated[INPUT_LAYER_IDX].leftCols(batchSize), workspace.mExpected.leftCols(batchSize));
+                    }
+                    timer.end(DATA_PHASE);
+
+                    if (NNFRAMEWORK_ZERO == batchRows)
+                    {
+                        break;
+                    }
+                    trainingData.epochRows.fetch_add(batchRows, std::memory_order_relaxed);
+
+                    // forward pass trough NNetwork, Weights and Biases may be updated by other threads in the meantime
+                    forwardPass(workspace, batchRows, true);
+                    timer.end(FORWARD_PHASE);
+
                     // calculate losses and metrics
-                    lossAndMetrics = calculateLossAndMetrics(expectedData, rowIdx);
-                    loss += std::get<0>(lossAndMetrics);
-                    metrics += std::get<1>(lossAndMetrics);
+                    workspace.mEpochMetrics += calculateLossAndMetrics(workspace, batchRows, workspace.mEpochLoss);
+                    timer.end(LOSS_PHASE);
+
+                    // backpropagation trough the NNetwork, gradients are averaged over the batch
+                    backPropagation(workspace, batchRows, static_cast<Scalar>(1.0) / static_cast<Scalar>(batchRows));
+                    timer.end(BACKPROP_PHASE);
+
+                    // update shared layer coefficients without locking
+                    ((*mModelConfigPtr->mOptimizerPtr))(mParameters, workspace.mGradients);
+                    timer.end(OPTIMIZER_PHASE);
+                }
+
+                // all threads have to finish the epoch before loss and metrics are summed
+                timer.begin();
+                if (false == synchronizeThreads(syncPoint, trainingData))
+                {
+                    return;
+                }
+                timer.end(REDUCE_PHASE);
+
+                if (0U == threadIdx)
+                {
+                    // save loss and metrics of each epoh
+                    saveEpochResults(ep, std::chrono::duration<double>(std::chrono::steady_clock::now() - epochStart).count(), trainingData.epochRows.load(), timer);
+
+                    // notify training observers
+                    notifyEpochEnd(ep, epochs, trainingData.epochRows.load());
+                }
+            }
+        }
+
+        // Wait for all training threads at the synchronization point
+        bool Model::synchronizeThreads(std::barrier<>& syncPoint, const TrainingData& trainingData) const
+        {
+            syncPoint.arrive_and_wait();
+
+            // aborted thread may be seen one phase earlier by some of the threads than by the others
+            // thus each stopping thread leaves the synchronization point as well and no thread waits for the stopped ones
+            if (true == trainingData.aborted.load(std::memory_order_relaxed))
+            {
+                syncPoint.arrive_and_drop();
+                return false;
+            }
+
+            return true;
+        }
+
+        // Abort the training of all threads because of the exception thrown by this thread
+        void Model::abortTraining(std::barrier<>& syncPoint, TrainingData& trainingData, const std::exception_ptr error) const
+        {
+            // first exception is kept, exceptions of the other threads are most likely caused by the same problem
+            {
+                std::lock_guard<std::mutex> lock(trainingData.errorMutex);
+                if (nullptr == trainingData.error)
+                {
+                    trainingData.error = error;
+                }
+            }
+            trainingData.aborted.store(true, std::memory_order_relaxed);
+
+            // this thread leaves the synchronization point, the rest of the threads stop at the next synchronization point
+            syncPoint.arrive_and_drop();
+        }
 
-                    // Log epoch status
-                    std::cout << "Epoch: " << (ep + 1) << " -> Loss: " << (loss.sum() / inputData.rows()) << " Accuracy: " << (metrics / 100.0) << "\r";
-                    std::cout.flush();  
+        // Check if training data rows are shuffled at the beginning of the epoch
+        bool Model::isShuffleEpoch(const uint32_t ep) const
+        {
+            return (true == mModelConfigPtr->mShuffleData->mShuffleOnFit) && (NNFRAMEWORK_ZERO == (ep % mModelConfigPtr->mShuffleData->mShuffleStep));
+        }
+
+        // Save loss, metrics and profile of the epoch into the ModelHistory
+        void Model::saveEpochResults(const uint32_t ep, const double epochTime, const uint32_t rowsNo, const PhaseTimer& timer)
+        {
+            std::tuple<Scalar, double> lossAndMetrics = reduceLossAndMetrics();
+            mHistory.hLoss[ep] = (NNFRAMEWORK_ZERO != rowsNo) ? (std::get<0>(lossAndMetrics) / rowsNo) : static_cast<Scalar>(0.0);
+            mHistory.hAccuracy[ep] = std::get<1>(lossAndMetrics) / 100.0; // get percentage in range [0, 1]
 
-                    // backpropagation trough the NNetwork
-                    backPropagation(expectedData.row(rowIdx));
+            // save epoch time and time of each training phase
+            saveEpochProfile(ep, epochTime, rowsNo, timer);
+        }
 
-                    // update layer coefficients based on backpropagation gradient calculation
-                    ((*mModelConfigPtr->mOptimizerPtr))(mLayers);
+        // Training state of the current epoch based on the loss and metrics accumulated by all threads
+        Callbacks::TrainingState Model::getTrainingState(const uint32_t ep, const uint32_t epochs, const uint32_t batch, const uint32_t rowsDone, const uint32_t rowsNo) const
+        {
+            std::tuple<Scalar, double> lossAndMetrics = reduceLossAndMetrics();
+            const Scalar loss = (NNFRAMEWORK_ZERO != rowsDone) ? (std::get<0>(lossAndMetrics) / rowsDone) : static_cast<Scalar>(0.0);
+
+            return Callbacks::TrainingState { ep, epochs, batch, rowsDone, rowsNo, loss, std::get<1>(lossAndMetrics) / 100.0 };
+        }
+
+        // Index of the batch holding the last of the data rows taken in the epoch
+        uint32_t Model::getLastBatchIdx(const uint32_t rowsNo) const
+        {
+            return (NNFRAMEWORK_ZERO != rowsNo) ? ((rowsNo - 1U) / mModelConfigPtr->mBatchSize) : 0U;
+        }
+
+        // Notify training observers about the end of the epoch
+        void Model::notifyEpochEnd(const uint32_t ep, const uint32_t epochs, const uint32_t rowsNo) const
+        {
+            if (false == mModelConfigPtr->mCallbacks.empty())
+            {
+                const Callbacks::TrainingState state { ep, epochs, getLastBatchIdx(rowsNo), rowsNo, rowsNo, 
+                                                       mHistory.hLoss[ep], static_cast<double>(mHistory.hAccuracy[ep]) };
+                for (const auto& callback : mModelConfigPtr->mCallbacks)
+                {
+                    callback->onEpochEnd(state);
                 }
-                std::cout << std::endl;
+            }
+        }
 
-                // save loss and metrics of each epoh
-                mHistory.hLoss.conservativeResize(ep + 1); // resize without coefficient destruction
-                mHistory.hLoss[ep] = loss.sum() / inputData.rows();
+        // Sum loss and metrics accumulated in the current epoch by all threads
+        std::tuple<Scalar, double> Model::reduceLossAndMetrics() const
+        {
+            Scalar loss = 0.0;
+            double metrics = 0.0;
 
-                mHistory.hAccuracy.conservativeResize(ep + 1); // resize without coefficient destruction
-                mHistory.hAccuracy[ep] = metrics / 100.0; // get percentage in range [0, 1]
+            for (uint16_t threadIdx = 0; threadIdx < mModelConfigPtr->mThreadsNo; ++threadIdx)
+            {
+                loss += mWorkspaces[threadIdx]->mEpochLoss.sum();
+                metrics += mWorkspaces[threadIdx]->mEpochMetrics;
             }
+
+            return std::make_tuple(loss, metrics);
+        }
+
+        // Save epoch time, throughput and phase times of the epoch into the ModelHistory
+        void Model::saveEpochProfile(const uint32_t ep, const double epochTime, const uint32_t rowsNo, const PhaseTimer& timer)
+        {
+            mHistory.hEpochTime[ep] = epochTime;
+            mHistory.hSamplesPerSec[ep] = (epochTime > 0.0) ? (rowsNo / epochTime) : 0.0;
+
+            mHistory.hShuffleTime[ep] = timer.times[SHUFFLE_PHASE];
+            mHistory.hDataTime[ep] = timer.times[DATA_PHASE];
+            mHistory.hForwardTime[ep] = timer.times[FORWARD_PHASE];
+            mHistory.hLossTime[ep] = timer.times[LOSS_PHASE];
+            mHistory.hBackpropTime[ep] = timer.times[BACKPROP_PHASE];
+            mHistory.hReduceTime[ep] = timer.times[REDUCE_PHASE];
+            mHistory.hOptimizerTime[ep] = timer.times[OPTIMIZER_PHASE];
         }
 
         // Trained model predict on provided input data
-        Eigen::MatrixXd Model::modelPredict(Eigen::MatrixXd& inputData)
+        Matrix Model::modelPredict(const Eigen::Ref<const Matrix>& inputData)
+        {
+            // check if model is compiled
+            checkIsModelCompiled(__FUNCTION__);
+
+            Matrix predictedData(inputData.rows(), mLayers[OUTPUT_LAYER_IDX(mLayersNo)]->get_mPerceptronNo());
+
+            modelPredict(inputData, predictedData);
+
+            // return output of the Neural Network
+            return predictedData;
+        }
+
+        // Trained model predict on provided input data, predictions are written into predictedData
+        void Model::modelPredict(const Eigen::Ref<const Matrix>& inputData, Eigen::Ref<Matrix> predictedData)
+        {
+            // check if model is compiled
+            checkIsModelCompiled(__FUNCTION__);
+
+            // intermediate results are stored in the Workspace of the first training thread
+            modelPredict(*mWorkspaces[0], inputData, predictedData);
+        }
+
+        // Trained model predict on provided input data trough the provided Workspace
+        void Model::modelPredict(Workspace::Workspace& workspace, const Eigen::Ref<const Matrix>& inputData, Eigen::Ref<Matrix> predictedData) const
         {
             // check if model is compiled
             checkIsModelCompiled(__FUNCTION__);
@@ -164,26 +789,55 @@ namespace NNFramework
             isDataEmpty(__FUNCTION__, inputData);
 
             // check if input data has the same number of columns as number of rows in input layer of NN
-            checkRowColDim(__FUNCTION__, inputData, *(mLayers[INPUT_LAYER_IDX]->get_mLayerZActivated()));
+            checkRowColDim(__FUNCTION__, inputData, mLayers[INPUT_LAYER_IDX]->get_mPerceptronNo());
 
-            // start predicting
-            uint32_t outputLayerRows = mLayers[OUTPUT_LAYER_IDX(mLayersNo)]->get_mLayerZActivated()->rows();
-            Eigen::MatrixXd predictedData(inputData.rows(), outputLayerRows);
-            
-            // for each data row in inputData
-            for (uint32_t rowIdx = 0; rowIdx < inputData.rows(); ++rowIdx)
+            // check if there is a row in predicted data for each row of input data
+            // check if predicted data has the same number of columns as number of rows in output layer of NN
+            checkInExpRowDim(__FUNCTION__, inputData, predictedData);
+            checkRowColDim(__FUNCTION__, predictedData, mLayers[OUTPUT_LAYER_IDX(mLayersNo)]->get_mPerceptronNo());
+
+            // for each tile of data rows in inputData
+            // tiles bound the memory used by the layer matrices while keeping one matrix-matrix product per layer
+            // tile size is limited by the capacity of the provided Workspace
+            for (uint32_t rowIdx = 0; rowIdx < inputData.rows(); rowIdx += workspace.mBatchCapacity)
             {
+                const uint32_t tileRows = std::min<uint32_t>(workspace.mBatchCapacity, inputData.rows() - rowIdx);
+
+                // each data row of the tile becomes one column of the input layer
+                workspace.mLayerZActivated[INPUT_LAYER_IDX].leftCols(tileRows) = inputData.middleRows(rowIdx, tileRows).transpose();
+
                 // forward pass trough NNetwork
-                forwardPass(inputData, rowIdx);
+                forwardPass(workspace, tileRows, false);
 
-                // save outputs
-                std::shared_ptr<Eigen::MatrixXd> outputLayerZActivated = mLayers[OUTPUT_LAYER_IDX(mLayersNo)]->get_mLayerZActivated();
-                Eigen::VectorXd predictions = (*outputLayerZActivated);
-                predictedData.row(rowIdx) = predictions;
+                // save outputs of the whole tile
+                predictedData.middleRows(rowIdx, tileRows) = workspace.mLayerZActivated[OUTPUT_LAYER_IDX(mLayersNo)].leftCols(tileRows).transpose();
             }
+        }
 
-            // return output of the Neural Network
-            return predictedData;
+        // Fold the input scaler into the Weights and Bias of the first hidden layer
+        void Model::foldInputScaler(const Scaler::Scaler& inScaler)
+        {
+            // loaded model holds its weights even before it is compiled
+            if(false == mIsLoaded)
+            {
+                checkIsModelCompiled(__FUNCTION__);
+            }
+
+            if((mLayersNo < 2U) || (inScaler.get_mColumnsNo() != mLayers[INPUT_LAYER_IDX]->get_mPerceptronNo()) || (NNFRAMEWORK_ZERO == inScaler.get_mCount()))
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Input scaler does not match the input layer of the model!");
+            }
+
+            Eigen::Map<Matrix>& weights = mLayers[INPUT_LAYER_IDX + 1U]->get_mLayerWeights();
+            Eigen::Map<Matrix>& bias = mLayers[INPUT_LAYER_IDX + 1U]->get_mLayerBias();
+
+            // folded coefficients are computed in double precision, rounding happens only once per coefficient
+            const Eigen::MatrixXd foldedWeights = weights.cast<double>() * inScaler.get_mScale().cast<double>().asDiagonal();
+            const Eigen::VectorXd foldedBias = bias.col(0).cast<double>() - (foldedWeights * inScaler.get_mOffset().cast<double>());
+
+            weights = foldedWeights.cast<Scalar>();
+            bias.col(0) = foldedBias.cast<Scalar>();
         }
 
         // Show model summary by printing it on std::cout
@@ -215,6 +869,56 @@ namespace NNFramework
 
         }
 
+        // Show training profile of the last modelFit() by printing it on std::cout
+        void Model::modelProfileSummary() const
+        {
+            // check if model is compiled
+            checkIsModelCompiled(__FUNCTION__);
+
+            const double totalTime = mHistory.hEpochTime.sum();
+            const Eigen::Index epochsNo = mHistory.hEpochTime.size();
+
+            std::cout << "**************************************" << std::endl;
+            std::cout << "Model training profile: " << std::endl;
+            std::cout << "**************************************" << std::endl;
+            std::cout << "Epochs = " << epochsNo << std::endl;
+            std::cout << "Total time = " << totalTime << " s" << std::endl;
+
+            if(NNFRAMEWORK_ZERO != epochsNo)
+            {
+                std::cout << "Average epoch time = " << (totalTime / epochsNo) << " s" << std::endl;
+                std::cout << "Average throughput = " << (mHistory.hSamplesPerSec.sum() / epochsNo) << " samples/s" << std::endl;
+            }
+
+            if(true == mModelConfigPtr->mProfiling)
+            {
+                const std::array<std::tuple<const char*, double>, TRAINING_PHASES_NO> phases = {
+                    std::make_tuple("Shuffle", static_cast<double>(mHistory.hShuffleTime.sum())),
+                    std::make_tuple("Data loading", static_cast<double>(mHistory.hDataTime.sum())),
+                    std::make_tuple("Forward pass", static_cast<double>(mHistory.hForwardTime.sum())),
+                    std::make_tuple("Loss and metrics", static_cast<double>(mHistory.hLossTime.sum())),
+                    std::make_tuple("Backpropagation", static_cast<double>(mHistory.hBackpropTime.sum())),
+                    std::make_tuple("Gradients reduction", static_cast<double>(mHistory.hReduceTime.sum())),
+                    std::make_tuple("Optimizer", static_cast<double>(mHistory.hOptimizerTime.sum())) };
+
+                std::cout << "**************************************" << std::endl;
+                for (const auto& phase : phases)
+                {
+                    std::cout << std::get<0>(phase) << " = " << std::get<1>(phase) << " s";
+                    if(totalTime > 0.0)
+                    {
+                        std::cout << " (" << (100.0 * std::get<1>(phase) / totalTime) << " %)";
+                    }
+                    std::cout << std::endl;
+                }
+            }
+            else
+            {
+                std::cout << "Training phases are not measured, enable mProfiling in the ModelConfiguration." << std::endl;
+            }
+            std::cout << "**************************************" << std::endl;
+        }
+
         // Check if model is compiled
         void Model::checkIsModelCompiled(const std::string fName) const
         {
@@ -225,9 +929,29 @@ namespace NNFramework
             }   
         }
 
-        // Check if data matrix (Eigen::MatrixXd) is empty
+        // Check if configured batch size is greater than zero
+        void Model::checkBatchSize(const std::string fName) const
+        {
+            if(NNFRAMEWORK_ZERO == mModelConfigPtr->mBatchSize)
+            {
+                std::cout << fName << ": ";
+                throw std::runtime_error("Batch size must be greater than zero!");
+            }
+        }
+
+        // Check if configured number of threads is greater than zero
+        void Model::checkThreadsNo(const std::string fName) const
+        {
+            if(NNFRAMEWORK_ZERO == mModelConfigPtr->mThreadsNo)
+            {
+                std::cout << fName << ": ";
+                throw std::runtime_error("Number of threads must be greater than zero!");
+            }
+        }
+
+        // Check if data matrix (Matrix) is empty
         // throws an exception if data matrix is empty
-        void Model::isDataEmpty(const std::string fName, const Eigen::MatrixXd& data) const
+        void Model::isDataEmpty(const std::string fName, const Eigen::Ref<const Matrix>& data) const
         {
             if(NNFRAMEWORK_ZERO == data.size())
             {
@@ -238,7 +962,7 @@ namespace NNFramework
 
         // Check if input data and expected data have the same amount of rows
         // Check if there is a pair for each input data tensor in expected data and vice versa
-        void Model::checkInExpRowDim(const std::string fName, const Eigen::MatrixXd& inData, const Eigen::MatrixXd& expData) const
+        void Model::checkInExpRowDim(const std::string fName, const Eigen::Ref<const Matrix>& inData, const Eigen::Ref<const Matrix>& expData) const
         {
             if(inData.rows() != expData.rows())
             {
@@ -248,25 +972,80 @@ namespace NNFramework
             }
         }
 
-        // Check if the input Matrix has the same amount of columns as the number of rows in layer data
-        void Model::checkRowColDim(const std::string fName, const Eigen::MatrixXd& inData, const Eigen::MatrixXd& layerData) const
+        // Check if the input Matrix has the same amount of columns as the number of perceptrons in layer
+        void Model::checkRowColDim(const std::string fName, const Eigen::Ref<const Matrix>& inData, const uint32_t perceptronNo) const
         {
-            if(inData.cols() != layerData.rows())
+            if(inData.cols() != perceptronNo)
             {
                 std::cout << fName << ": ";
                 throw std::runtime_error("Input data Matrix does not have the same amount of rows as the number of columns in layer data!");
             }        
         }
 
+        // Check if the data rows of the data source have one value for each perceptron of the input and output layer
+        void Model::checkDataSourceDim(const std::string fName, const DataSource::DataSource& dataSource) const
+        {
+            if((dataSource.inputColsNo() != mLayers[INPUT_LAYER_IDX]->get_mPerceptronNo()) || 
+               (dataSource.expectedColsNo() != mLayers[OUTPUT_LAYER_IDX(mLayersNo)]->get_mPerceptronNo()))
+            {
+                std::cout << fName << ": ";
+                throw std::runtime_error(dataSource.name() + " data rows do not match the input and output layer of the model!");
+            }
+        }
+
         // Initialize all layers coefficients
         void Model::initializeLayers()
         {
-            std::shared_ptr<Eigen::MatrixXd> layerWeights;
-            std::shared_ptr<Eigen::MatrixXd> layerZ;
-            std::shared_ptr<Eigen::MatrixXd> layerBias;
-            std::shared_ptr<Eigen::MatrixXd> layerZActivated;
-            std::shared_ptr<Eigen::MatrixXd> layerWGradients;
-            std::shared_ptr<Eigen::MatrixXd> layerBGradients;
+            // parameters restored by loadModel() are kept, otherwise the parameters buffer is allocated at once
+            if(false == mIsLoaded)
+            {
+                mParametersStorage = Vector::Zero(getParametersNo());
+                new (&mParameters) Eigen::Map<Vector>(mParametersStorage.data(), mParametersStorage.size());
+            }
+
+            // bind layer Weights and Bias to the Model parameters buffer
+            bindLayers();
+
+            if(true == mIsLoaded)
+            {
+                return;
+            }
+
+            // skip first layer, as first (input) layer does not have weights nor biases
+            for(uint32_t i = (INPUT_LAYER_IDX + 1U); i < mLayersNo; ++i)
+            {
+                // initialize layer weights based on the activation function
+                (*mWeightInitializerPtr).initializeWeights(mLayers[i]->get_mLayerWeights(), mLayers[i]->mActivationPtr->name());
+
+                // initialize layer biases                        
+                mLayers[i]->get_mLayerBias().setOnes();
+            }
+        }
+
+        // Number of Weights and Biases of all layers
+        Eigen::Index Model::getParametersNo() const
+        {
+            // each layer (except the input layer) holds Weights (perceptronNo x prevPercNo) and Bias (perceptronNo x 1)
+            Eigen::Index parametersNo = 0;
+            for(uint32_t i = (INPUT_LAYER_IDX + 1U); i < mLayersNo; ++i)
+            {
+                Eigen::Index perceptronNo = mLayers[i]->get_mPerceptronNo();
+                Eigen::Index prevPercNo = mLayers[PREVIOUS_LAYER_IDX(i)]->get_mPerceptronNo();
+
+                parametersNo += perceptronNo * (prevPercNo + 1);
+            }
+
+            return parametersNo;
+        }
+
+        // Bind Weights and Bias of each layer to its part of the parameters buffer
+        void Model::bindLayers()
+        {
+            mLayerOffsets.assign(mLayersNo, 0);
+            mLearnableCoeffs = NNFRAMEWORK_ZERO;
+
+            // offset of the current layer in the parameters and gradients buffers
+            Eigen::Index offset = 0;
 
             // iterate trough layers
             for(auto it = mLayers.begin(); it != mLayers.end(); ++it)
@@ -274,166 +1053,192 @@ namespace NNFramework
                 uint8_t layerId = (*it)->get_mLayerId();
                 uint8_t perceptronNo = (*it)->get_mPerceptronNo();
                 uint8_t prevPercNo = (INPUT_LAYER_IDX == layerId ? perceptronNo : mLayers[PREVIOUS_LAYER_IDX(layerId)]->get_mPerceptronNo());
-        
-                // initialize layer coefficients
-                layerWeights = (*it)->get_mLayerWeights();
-                layerZ = (*it)->get_mLayerZ();
-                layerBias = (*it)->get_mLayerBias();
-                layerZActivated = (*it)->get_mLayerZActivated();
-                layerWGradients = (*it)->get_mLayerWGradients();
-                layerBGradients = (*it)->get_mLayerBGradients();
-
-                *layerZ = Eigen::MatrixXd::Zero(perceptronNo, MATRIX_COL_INIT_VAL);
-                *layerZActivated = Eigen::MatrixXd::Zero(perceptronNo, MATRIX_COL_INIT_VAL);
-
-                // gradients of Weights matrix has the same dimensions as the Weights matrix
-                *layerWGradients = Eigen::MatrixXd::Zero(perceptronNo, prevPercNo);
-                // gradients of Bias matrix has the same dimensions as the Bias matrix
-                *layerBGradients = Eigen::MatrixXd::Zero(perceptronNo, MATRIX_COL_INIT_VAL);
-
-                // Layer weights matrix construction
-                *layerWeights = Eigen::MatrixXd::Zero(perceptronNo, prevPercNo);
 
                 if(INPUT_LAYER_IDX == layerId)
                 {
                     // Input layer does not contain Weights, Biases nor Activation
-                    *layerBias = Eigen::MatrixXd::Zero(perceptronNo, MATRIX_COL_INIT_VAL);
+                    (*it)->set_mParameters(nullptr, 0, 0);
 
                     (*it)->set_mLearnableCoeffs(NNFRAMEWORK_ZERO);
                 }
                 else
                 {
-                    // initialize layer weights based on the activation function
-                    (*mWeightInitializerPtr).initializeWeights(layerWeights, (*it)->mActivationPtr->name());
-
-                    // initialize layer biases                        
-                    *layerBias = Eigen::MatrixXd::Ones(perceptronNo, MATRIX_COL_INIT_VAL);
+                    // bind layer Weights and Bias to the Model parameters buffer
+                    (*it)->set_mParameters(mParameters.data() + offset, perceptronNo, prevPercNo);
+                    mLayerOffsets[layerId] = offset;
 
                     // calculate learnable coefficients
-                    // learnableCoeffs = noOfPerceptrons * (noOfWeights + noOfInputs) + 1 (bias)
-                    uint32_t noOfCoeffs = (perceptronNo * (2 * prevPercNo)) + 1;
+                    // learnableCoeffs = noOfPerceptrons * noOfInputs (weights) + noOfPerceptrons (biases)
+                    uint32_t noOfCoeffs = perceptronNo * (prevPercNo + 1);
 
                     (*it)->set_mLearnableCoeffs(noOfCoeffs);
                     mLearnableCoeffs += noOfCoeffs;
+
+                    offset += noOfCoeffs;
                 }
             }
         }
 
-        // Forward pass
-        void Model::forwardPass(const Eigen::MatrixXd& inputData, const uint32_t rowIdx)
+        // Allocate Workspaces of all training threads
+        void Model::initializeWorkspaces()
         {
-            // set input layer data
-            std::shared_ptr<Eigen::MatrixXd> inputLayerZ = mLayers[INPUT_LAYER_IDX]->get_mLayerZ();
-            std::shared_ptr<Eigen::MatrixXd> inputLayerZActivated = mLayers[INPUT_LAYER_IDX]->get_mLayerZActivated();
+            const uint32_t batchSize = mModelConfigPtr->mBatchSize;
+            const uint16_t threadsNo = std::max<uint16_t>(mModelConfigPtr->mThreadsNo, 1U);
 
-            *inputLayerZ = inputData.row(rowIdx);
-            (*inputLayerZ).transposeInPlace();
-            
-            // passtrough input values as activated
-            // f(x) = x
-            (*inputLayerZActivated) = (*inputLayerZ);    
+            mWorkspaces.clear();
 
-            // previous layer data
-            std::shared_ptr<Eigen::MatrixXd> prevLayerZActivated;
+            // first Workspace is used for training as well as for prediction tiles
+            mWorkspaces.push_back(std::make_unique<Workspace::Workspace>(mLayers, std::max(batchSize, PREDICT_TILE_ROWS), mParameters.size()));
+
+            // Workspaces of the additional threads only hold their share of the batch
+            // in Hogwild mode each thread propagates whole batches
+            const uint32_t threadBatchSize = (true == mModelConfigPtr->mHogwild) ? batchSize : ((batchSize + threadsNo - 1) / threadsNo);
+            for (uint16_t threadIdx = 1; threadIdx < threadsNo; ++threadIdx)
+            {
+                mWorkspaces.push_back(std::make_unique<Workspace::Workspace>(mLayers, threadBatchSize, mParameters.size()));
+            }
 
-            // current layer data
-            std::shared_ptr<Eigen::MatrixXd> layerWeights;
-            std::shared_ptr<Eigen::MatrixXd> layerZ;
-            std::shared_ptr<Eigen::MatrixXd> layerBias;
-            std::shared_ptr<Eigen::MatrixXd> layerZActivated;
+            // bind layer Weights and Bias gradients to the gradients reduced over all threads
+            // gradients of Weights and Bias matrices have the same dimensions as the Weights and Bias matrices
+            for (uint32_t i = (INPUT_LAYER_IDX + 1U); i < mLayersNo; ++i)
+            {
+                mLayers[i]->set_mGradients(mWorkspaces[0]->mGradients.data() + mLayerOffsets[i], mLayers[i]->get_mPerceptronNo(), mLayers[PREVIOUS_LAYER_IDX(i)]->get_mPerceptronNo());
+            }
+        }
+
+        // Forward pass
+        void Model::forwardPass(Workspace::Workspace& workspace, const uint32_t batchSize, const bool cacheDerivatives) const
+        {
+            // input layer Z activated already holds the input data
+            // passtrough input values as activated
+            // f(x) = x
 
             // iterate trough layers 
             // skip first layer, as first (input) layer does not have weights nor activations
             for (uint32_t i = 1; i < mLayersNo; ++i)
             {
                 // get previous layer data
-                prevLayerZActivated = mLayers[PREVIOUS_LAYER_IDX(i)]->get_mLayerZActivated();
+                auto prevLayerZActivated = workspace.mLayerZActivated[PREVIOUS_LAYER_IDX(i)].leftCols(batchSize);
 
                 // get current layer data
-                layerWeights = mLayers[i]->get_mLayerWeights();
-                layerZ = mLayers[i]->get_mLayerZ();
-                layerBias = mLayers[i]->get_mLayerBias();
-                layerZActivated = mLayers[i]->get_mLayerZActivated();
-
-                // z = Wx + b
-                (*layerZ) = ((*layerWeights) * (*prevLayerZActivated)) + (*layerBias);
-
-                // apply activation functor to the layer Z activated values
-                (*layerZActivated) = (*(mLayers[i]->mActivationPtr))(*layerZ);
+                const Eigen::Map<Matrix>& layerWeights = mLayers[i]->get_mLayerWeights();
+                const Eigen::Map<Matrix>& layerBias = mLayers[i]->get_mLayerBias();
+                auto layerZ = workspace.mLayerZ[i].leftCols(batchSize);
+                auto layerZActivated = workspace.mLayerZActivated[i].leftCols(batchSize);
+
+                // Z = WX + b
+                // one matrix-matrix product for the whole batch, bias is broadcasted to every column
+                layerZ.noalias() = layerWeights * prevLayerZActivated;
+                layerZ.colwise() += layerBias.col(0);
+
+                // apply activation functor to the layer Z values, result is written directly into Z activated
+                // during training dA/dZ is calculated together with the activation and cached for backpropagation
+                if(true == cacheDerivatives)
+                {
+                    auto layerZActivationDer = workspace.mLayerActivationDer[i].leftCols(batchSize);
+                    mLayers[i]->mActivationPtr->activateWithDerivative(layerZ, layerZActivated, layerZActivationDer);
+                }
+                else
+                {
+                    mLayers[i]->mActivationPtr->activate(layerZ, layerZActivated);
+                }
             } 
         }
 
         // Back propagation
-        void Model::backPropagation(const Eigen::MatrixXd& expData)
+        void Model::backPropagation(Workspace::Workspace& workspace, const uint32_t batchSize, const Scalar batchScale) const
         {
             // calculate gradients of the output layer
-            std::shared_ptr<Eigen::MatrixXd> layerZActivated = mLayers[OUTPUT_LAYER_IDX(mLayersNo)]->get_mLayerZActivated();
-            std::shared_ptr<Eigen::MatrixXd> layerWGradients = mLayers[OUTPUT_LAYER_IDX(mLayersNo)]->get_mLayerWGradients();
-            std::shared_ptr<Eigen::MatrixXd> layerBGradients = mLayers[OUTPUT_LAYER_IDX(mLayersNo)]->get_mLayerBGradients();
-            std::shared_ptr<Eigen::MatrixXd> prevLayerZActivated = mLayers[PREVIOUS_LAYER_IDX(mLayersNo - 1)]->get_mLayerZActivated();
+            const uint32_t outIdx = OUTPUT_LAYER_IDX(mLayersNo);
+
+            // gradients are written into the Workspace gradients buffer
+            Eigen::Map<Matrix> layerWGradients = layerWGradientsView(workspace, outIdx);
+            Eigen::Map<Matrix> layerBGradients = layerBGradientsView(workspace, outIdx);
+
+            auto layerZActivated = workspace.mLayerZActivated[outIdx].leftCols(batchSize);
+            auto prevLayerZActivated = workspace.mLayerZActivated[PREVIOUS_LAYER_IDX(outIdx)].leftCols(batchSize);
+            auto layerZActivationDer = workspace.mLayerActivationDer[outIdx].leftCols(batchSize);
+            auto lossDerivative = workspace.mLayerDelta[outIdx].leftCols(batchSize);
 
             // calculate derivative of the loss based on the output activation
-            Eigen::VectorXd lossDerivative = ((*mModelConfigPtr->mLossPtr))(expData.transpose(), *layerZActivated, true);
+            mModelConfigPtr->mLossPtr->derivative(workspace.mExpected.leftCols(batchSize), layerZActivated, lossDerivative);
 
-            // calculate derivative of the activated values of output layer
-            Eigen::VectorXd layerZActivationDer = (*(mLayers[OUTPUT_LAYER_IDX(mLayersNo)]->mActivationPtr))(*layerZActivated);
+            // derivative of the activated values of output layer dA/dZ is cached by the forward pass
 
             // calculate elementwise product dL/dY * dA / dZ, which is equal to dL/dB
-            lossDerivative = lossDerivative.cwiseProduct(layerZActivationDer);
+            // each column holds the gradient of one data row of the batch
+            lossDerivative.array() *= layerZActivationDer.array();
 
             // calculate overall gradient of the output layer
             // dL/dW = dL/dY * dY/dZ * dZ/dW
-            // .rowwise() assignment will boradcast prevLayerZActivated column vector 
-            // to all rows of layerWGradients
-            (*layerWGradients).rowwise() = (*prevLayerZActivated).reshaped().transpose();
-            (*layerWGradients) = (*layerWGradients).array().colwise() * lossDerivative.array();
+            // one matrix-matrix product accumulates the outer products of all data rows of the batch
+            // product and scaling are kept separate so the product is evaluated directly into the gradients buffer
+            layerWGradients.noalias() = lossDerivative * prevLayerZActivated.transpose();
+            layerWGradients *= batchScale;
 
             // calculate gradient of the bias term in output layer
             // dL/dB = dL/dY * dY/dZ * 1
             // we stored the loss derivative in respect to the output layer Z activated derivative 
             // in variable lossDerivative
-            (*layerBGradients) = lossDerivative;
+            layerBGradients.noalias() = lossDerivative.rowwise().sum() * batchScale;
 
             // calculate gradients of the rest of the layers
             // skip first and last layer
             for (uint32_t i = (mLayersNo - 2); i > NNFRAMEWORK_ZERO; --i)
             {
-                std::shared_ptr<Eigen::MatrixXd> nextLayerWeights = mLayers[NEXT_LAYER_IDX(i)]->get_mLayerWeights();
-                layerZActivated = mLayers[i]->get_mLayerZActivated();
-                layerWGradients = mLayers[i]->get_mLayerWGradients();
-                layerBGradients = mLayers[i]->get_mLayerBGradients();
-                prevLayerZActivated = mLayers[PREVIOUS_LAYER_IDX(i)]->get_mLayerZActivated();
-
-                // dL/dA = delta^T * nextLayerWeights
-                lossDerivative = lossDerivative.transpose() * (*nextLayerWeights);
+                const Eigen::Map<Matrix>& nextLayerWeights = mLayers[NEXT_LAYER_IDX(i)]->get_mLayerWeights();
+                auto nextLayerDelta = workspace.mLayerDelta[NEXT_LAYER_IDX(i)].leftCols(batchSize);
+                auto layerDelta = workspace.mLayerDelta[i].leftCols(batchSize);
+                auto layerZActivationDer = workspace.mLayerActivationDer[i].leftCols(batchSize);
+                auto prevLayerZActivated = workspace.mLayerZActivated[PREVIOUS_LAYER_IDX(i)].leftCols(batchSize);
+                Eigen::Map<Matrix> layerWGradients = layerWGradientsView(workspace, i);
+                Eigen::Map<Matrix> layerBGradients = layerBGradientsView(workspace, i);
+
+                // dL/dA = nextLayerWeights^T * delta
+                layerDelta.noalias() = nextLayerWeights.transpose() * nextLayerDelta;
             
-                // calculate layerZActivationDer
-                layerZActivationDer = (*(mLayers[i]->mActivationPtr))(*layerZActivated);
-
-                // dL/dB = dL/dA (dotprod) layerZActivationDer
-                (*layerBGradients) = lossDerivative.cwiseProduct(layerZActivationDer);
+                // delta = dL/dA (dotprod) layerZActivationDer, dA/dZ is cached by the forward pass
+                layerDelta.array() *= layerZActivationDer.array();
 
-                // dL/dW = dL/dA (dotprod) layerZActivationDer (dotprod) prevLayerZActivated
-                (*layerWGradients).colwise() = (*layerBGradients).reshaped();
-                (*layerWGradients) = (*layerWGradients).array().rowwise() * (*prevLayerZActivated).reshaped().array().transpose();
+                // dL/dW = delta * prevLayerZActivated^T, averaged over the batch
+                layerWGradients.noalias() = layerDelta * prevLayerZActivated.transpose();
+                layerWGradients *= batchScale;
 
-                // loss derivative for the next layer in backpropagation algorithm
-                lossDerivative = (*layerBGradients);
+                // dL/dB = delta, averaged over the batch
+                layerBGradients.noalias() = layerDelta.rowwise().sum() * batchScale;
             }
         }
 
-        // Return values: tuple[0] = loss, tuple[1] = metrics
-        std::tuple<Eigen::MatrixXd, double> Model::calculateLossAndMetrics(const Eigen::MatrixXd& expectedData, const uint32_t rowIdx)
+        // View of the layer Weights gradients inside of the Workspace gradients buffer
+        Eigen::Map<Matrix> Model::layerWGradientsView(Workspace::Workspace& workspace, const uint32_t layerIdx) const
         {
-            // CHECK MATRICES AND VECTORS AS INPUT VALUES 
-            Eigen::MatrixXd outputLayerZActivated = *(mLayers[OUTPUT_LAYER_IDX(mLayersNo)]->get_mLayerZActivated());
-            Eigen::VectorXd modelOutput(Eigen::Map<Eigen::VectorXd>(outputLayerZActivated.data(), outputLayerZActivated.cols() * outputLayerZActivated.rows()));
-            
-            Eigen::MatrixXd expectedOutput = expectedData.row(rowIdx);
-            Eigen::MatrixXd loss = ((*mModelConfigPtr->mLossPtr))(expectedOutput, outputLayerZActivated);
-            double metrics = ((*mModelConfigPtr->mMetricsPtr))(modelOutput, expectedOutput);       
+            return Eigen::Map<Matrix>(workspace.mGradients.data() + mLayerOffsets[layerIdx], 
+                                      mLayers[layerIdx]->get_mPerceptronNo(), mLayers[PREVIOUS_LAYER_IDX(layerIdx)]->get_mPerceptronNo());
+        }
+
+        // View of the layer Bias gradients inside of the Workspace gradients buffer
+        Eigen::Map<Matrix> Model::layerBGradientsView(Workspace::Workspace& workspace, const uint32_t layerIdx) const
+        {
+            const Eigen::Index perceptronNo = mLayers[layerIdx]->get_mPerceptronNo();
+            const Eigen::Index prevPercNo = mLayers[PREVIOUS_LAYER_IDX(layerIdx)]->get_mPerceptronNo();
+
+            return Eigen::Map<Matrix>(workspace.mGradients.data() + mLayerOffsets[layerIdx] + (perceptronNo * prevPercNo), perceptronNo, MATRIX_COL_INIT_VAL);
+        }
+
+        // Calculate loss and metrics of the last forward pass
+        Scalar Model::calculateLossAndMetrics(Workspace::Workspace& workspace, const uint32_t batchSize, Vector& loss) const
+        {
+            // each column of the output layer holds the prediction of one data row of the batch
+            auto outputLayerZActivated = workspace.mLayerZActivated[OUTPUT_LAYER_IDX(mLayersNo)].leftCols(batchSize);
+            auto expectedOutput = workspace.mExpected.leftCols(batchSize);
+            auto batchLoss = workspace.mLoss.leftCols(batchSize);
+
+            // loss of each output summed over the batch rows
+            mModelConfigPtr->mLossPtr->loss(expectedOutput, outputLayerZActivated, batchLoss);
+            loss.noalias() += batchLoss.rowwise().sum();
 
-            return std::make_tuple(loss, metrics);    
+            // metrics functors average over all provided values, scale back to the sum over the batch rows
+            return ((*mModelConfigPtr->mMetricsPtr))(outputLayerZActivated, expectedOutput) * batchSize;
         }
     }
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Core/WeightInitializer.hpp"
+#include "Utilities/Random.hpp"
 
 namespace NNFramework
 {
@@ -7,38 +8,39 @@ namespace NNFramework
         namespace WeightInitializer
         {
             // Initialize weights based on the activation function
-            void WeightInitializer::initializeWeights(const std::shared_ptr<Eigen::MatrixXd>& weights, std::string activationName)
+            void WeightInitializer::initializeWeights(Eigen::Ref<Matrix> weights, std::string activationName)
             {
 
                 // Activations::ActivationTypeEnum won't work here as we are having pointers to the 
                 // Activations::ActivationFunctor in the actual layers
                 // room for future improvement
-                if("Sigmoid" == activationName)
+                // weights of each layer are generated in bulk from the next stream of the global seed
+                // Xavier/Glorot for the saturating activations (Sigmoid, HardSigmoid, Tanh), Kaiming/He otherwise
+                if(("Sigmoid" == activationName) || ("SigmoidFast" == activationName) || ("HardSigmoid" == activationName) ||
+                   ("Tanh" == activationName) || ("TanhFast" == activationName))
                 {
-                    set_XavierGlorotParameters((*weights).cols(), (*weights).rows());
-                    *weights = (*weights).unaryExpr([this](double x){ return mUniformDistribution(mGenerator); });
+                    set_XavierGlorotParameters(weights.cols(), weights.rows());
+                    Random::fillUniform(weights, -mUniformLimit, mUniformLimit, Random::nextSeed());
                 }
                 else
                 {
-                    set_KaimingHeParameters((*weights).cols());
-                    *weights = (*weights).unaryExpr([this](double x){ return mNormalDistribution(mGenerator); });
+                    set_KaimingHeParameters(weights.cols());
+                    Random::fillNormal(weights, 0.0, mNormalStdDev, Random::nextSeed());
                 }
             }
 
-            // set normal distribution parameters
+            // set uniform distribution parameters
             void WeightInitializer::set_XavierGlorotParameters(const double& prevPercNo, const double& perceptronNo)
             {
-                std::uniform_real_distribution<double>::param_type distParam(-1 * std::sqrt(2.0) / std::sqrt((prevPercNo + perceptronNo)), std::sqrt(2.0) / std::sqrt((prevPercNo + perceptronNo)));
-                mUniformDistribution.param(distParam);
+                mUniformLimit = static_cast<Scalar>(std::sqrt(2.0) / std::sqrt((prevPercNo + perceptronNo)));
             }
             
-            // set uniform distribution parameters
+            // set normal distribution parameters
             void WeightInitializer::set_KaimingHeParameters(const double& prevPercNo)
             {
-                std::normal_distribution<double>::param_type distParam(0.0, std::sqrt(2.0 / prevPercNo));
-                mNormalDistribution.param(distParam);
+                mNormalStdDev = static_cast<Scalar>(std::sqrt(2.0 / prevPercNo));
             }
 
         }
     }
-}
\ No newline at end of file
+}
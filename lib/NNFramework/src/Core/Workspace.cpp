@@ -0,0 +1,42 @@
+#include "Core/Workspace.hpp"
+
+namespace NNFramework
+{
+    namespace Model
+    {
+        namespace Workspace
+        {
+            // Allocate forward pass only Workspace buffers for the provided layers
+            Workspace::Workspace(const std::vector<std::unique_ptr<Layers::Layer>>& layers, const uint32_t batchCapacity) : mEpochMetrics(0.0), mBatchCapacity(batchCapacity)
+            {
+                for(auto it = layers.begin(); it != layers.end(); ++it)
+                {
+                    uint8_t perceptronNo = (*it)->get_mPerceptronNo();
+
+                    mLayerZ.push_back(Matrix::Zero(perceptronNo, batchCapacity));
+                    mLayerZActivated.push_back(Matrix::Zero(perceptronNo, batchCapacity));
+                }
+            }
+
+            // Allocate training Workspace buffers for the provided layers
+            Workspace::Workspace(const std::vector<std::unique_ptr<Layers::Layer>>& layers, const uint32_t batchCapacity, const Eigen::Index parametersNo) : Workspace(layers, batchCapacity)
+            {
+                for(auto it = layers.begin(); it != layers.end(); ++it)
+                {
+                    uint8_t perceptronNo = (*it)->get_mPerceptronNo();
+
+                    mLayerDelta.push_back(Matrix::Zero(perceptronNo, batchCapacity));
+                    mLayerActivationDer.push_back(Matrix::Zero(perceptronNo, batchCapacity));
+                }
+
+                uint8_t outputPerceptronNo = layers[OUTPUT_LAYER_IDX(layers.size())]->get_mPerceptronNo();
+
+                mExpected = Matrix::Zero(outputPerceptronNo, batchCapacity);
+                mLoss = Matrix::Zero(outputPerceptronNo, batchCapacity);
+
+                mGradients = Vector::Zero(parametersNo);
+                mEpochLoss = Vector::Zero(outputPerceptronNo);
+            }
+        }
+    }
+}
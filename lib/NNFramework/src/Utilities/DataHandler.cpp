@@ -1,9 +1,149 @@
 #include "Utilities/DataHandler.hpp"
+#include "Utilities/MappedFile.hpp"
+#include <charconv>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <exception>
+#include <algorithm>
+#include <numeric>
 
 namespace NNFramework
 {
     namespace DataHandler
     {
+        // Value delimiters of the data file, carriage return of the Windows line endings is treated as a delimiter
+        static inline bool isDelimiter(const char c)
+        {
+            return (' ' == c) || ('\t' == c) || (',' == c) || ('\r' == c);
+        }
+
+        // Find the end of the line starting at begin (position of '\n' or end)
+        static inline const char* findLineEnd(const char* begin, const char* end)
+        {
+            const void* lineEnd = std::memchr(begin, '\n', static_cast<size_t>(end - begin));
+
+            return (nullptr == lineEnd) ? end : static_cast<const char*>(lineEnd);
+        }
+
+        // Check if the line holds at least one value
+        static inline bool isDataLine(const char* lineBegin, const char* lineEnd)
+        {
+            return (lineEnd != std::find_if_not(lineBegin, lineEnd, isDelimiter));
+        }
+
+        // Parse one value of the line into value
+        // Return value: position after the parsed value, nullptr if the value is not a number
+        static inline const char* parseValue(const char* begin, const char* lineEnd, Scalar& value)
+        {
+            // std::from_chars() does not accept the leading plus sign
+            if('+' == *begin)
+            {
+                ++begin;
+            }
+
+            const std::from_chars_result result = std::from_chars(begin, lineEnd, value);
+
+            if((std::errc() != result.ec) || ((lineEnd != result.ptr) && (false == isDelimiter(*result.ptr))))
+            {
+                return nullptr;
+            }
+
+            return result.ptr;
+        }
+
+        // Count values in the line
+        static Eigen::Index countValues(const char* lineBegin, const char* lineEnd)
+        {
+            Eigen::Index valuesNo = 0;
+            Scalar value;
+
+            const char* it = std::find_if_not(lineBegin, lineEnd, isDelimiter);
+            while(lineEnd != it)
+            {
+                it = parseValue(it, lineEnd, value);
+                if(nullptr == it)
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Data file holds a value that is not a number!");
+                }
+
+                ++valuesNo;
+                it = std::find_if_not(it, lineEnd, isDelimiter);
+            }
+
+            return valuesNo;
+        }
+
+        // Count data lines of the chunk
+        static Eigen::Index countDataLines(const char* begin, const char* end)
+        {
+            Eigen::Index linesNo = 0;
+
+            while(begin < end)
+            {
+                const char* lineEnd = findLineEnd(begin, end);
+
+                if(true == isDataLine(begin, lineEnd))
+                {
+                    ++linesNo;
+                }
+
+                begin = lineEnd + 1;
+            }
+
+            return linesNo;
+        }
+
+        // Parse data lines of the chunk into the rows of inData and expData starting at rowIdx
+        static void parseDataLines(const char* begin, const char* end, Eigen::Index rowIdx, Matrix& inData, Matrix& expData)
+        {
+            const Eigen::Index inCol = inData.cols();
+            const Eigen::Index colsNo = inCol + expData.cols();
+
+            while(begin < end)
+            {
+                const char* lineEnd = findLineEnd(begin, end);
+                const char* it = std::find_if_not(begin, lineEnd, isDelimiter);
+                Eigen::Index colIdx = 0;
+
+                while(lineEnd != it)
+                {
+                    if(colIdx >= colsNo)
+                    {
+                        std::cout << __FUNCTION__ << ": ";
+                        throw std::runtime_error("Data row " + std::to_string(rowIdx) + " holds more than " + std::to_string(colsNo) + " values!");
+                    }
+
+                    Scalar& value = (colIdx < inCol) ? inData(rowIdx, colIdx) : expData(rowIdx, colIdx - inCol);
+
+                    it = parseValue(it, lineEnd, value);
+                    if(nullptr == it)
+                    {
+                        std::cout << __FUNCTION__ << ": ";
+                        throw std::runtime_error("Data row " + std::to_string(rowIdx) + " holds a value that is not a number!");
+                    }
+
+                    ++colIdx;
+                    it = std::find_if_not(it, lineEnd, isDelimiter);
+                }
+
+                // empty lines are skipped
+                if(NNFRAMEWORK_ZERO != colIdx)
+                {
+                    if(colIdx != colsNo)
+                    {
+                        std::cout << __FUNCTION__ << ": ";
+                        throw std::runtime_error("Data row " + std::to_string(rowIdx) + " holds " + std::to_string(colIdx) + " values instead of " + std::to_string(colsNo) + "!");
+                    }
+
+                    ++rowIdx;
+                }
+
+                begin = lineEnd + 1;
+            }
+        }
+
         // Retrieve singleton object reference
         std::unique_ptr<DataHandler>& DataHandler::getInstance()
         {
@@ -21,46 +161,288 @@ namespace NNFramework
             return instance;
         }
 
-        // Normalize data in range [0, 1]
-        Eigen::MatrixXd& DataHandler::normalizeData(Eigen::MatrixXd& data)
+        // Normalize data in range [0, 1], each column by its own min and max
+        Matrix& DataHandler::normalizeData(Matrix& data, Scaler::Scaler& scaler)
         {
-            double min = data.minCoeff();
-            double max = data.maxCoeff();
+            scaler = Scaler::Scaler(Scaler::Scaler::MIN_MAX);
 
-            data = data.unaryExpr([min, max](double x){ return (x - min) / (max - min); });
+            scaler.fit(data);
+            scaler.transform(data);
 
             return data;
         }
 
-        // Denormalize data from range [0, 1] to [min, max]
-        Eigen::MatrixXd& DataHandler::denormalizeData(Eigen::MatrixXd& data, double min, double max)
+        // Denormalize data from range [0, 1] to the [min, max] of each column
+        Matrix& DataHandler::denormalizeData(Matrix& data, const Scaler::Scaler& scaler)
         {
-            data = data.unaryExpr([min, max](double x){ return (x * (max - min) + min); });
+            scaler.inverseTransform(data);
 
             return data;
         }
 
+        // Reorder rows of data, row i of the result is row indices[i] of the original data
+        // columns are contiguous, thus each column is gathered into columnBuffer and copied back
+        // only a single column is held aside instead of the copy of the whole matrix
+        static void permuteRows(Matrix& data, const std::vector<Eigen::Index>& indices, std::vector<Scalar>& columnBuffer)
+        {
+            columnBuffer.resize(indices.size());
+
+            for(Eigen::Index j = 0; j < data.cols(); ++j)
+            {
+                Scalar* column = data.col(j).data();
+
+                for(size_t i = 0; i < indices.size(); ++i)
+                {
+                    columnBuffer[i] = column[indices[i]];
+                }
+
+                std::copy(columnBuffer.begin(), columnBuffer.end(), column);
+            }
+        }
+
         // Shuffle data matrices
         // shuffleData() shuffles data where original indices in inData matrix will match indices in expData matrix
         // i.e. shuffleData() considers inData[0] and expData[0] to be a pair (inData[0], expData[0])
-        // works with original matrices 
-        void DataHandler::shuffleData(Eigen::MatrixXd& inData, Eigen::MatrixXd& expData)
+        // works with original matrices, only the row indices are shuffled and the columns are gathered trough them
+        void DataHandler::shuffleData(Matrix& inData, Matrix& expData)
+        {
+            if(inData.rows() != expData.rows())
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Input data and expected data do not have the same number of rows!");
+            }
+
+            std::vector<Eigen::Index> indices(static_cast<size_t>(inData.rows()));
+            std::iota(indices.begin(), indices.end(), 0);
+
+            Random::Xoshiro256 engine(Random::nextSeed());
+            shuffleIndices(indices, engine);
+
+            std::vector<Scalar> columnBuffer;
+            permuteRows(inData, indices, columnBuffer);
+            permuteRows(expData, indices, columnBuffer);
+        }
+
+        // Shuffle row indices (Fisher-Yates), only the indices are moved
+        void DataHandler::shuffleIndices(std::vector<Eigen::Index>& indices, Random::Xoshiro256& engine) const
+        {
+            for(size_t i = indices.size(); i > 1U; --i)
+            {
+                const size_t j = static_cast<size_t>(Random::uniformIndex(engine, i));
+                std::swap(indices[i - 1U], indices[j]);
+            }
+        }
+
+        // Gather data rows indices[firstIdx, firstIdx + rowsNo) of data into the leftmost rowsNo columns of batch
+        void DataHandler::gatherRows(const Matrix& data, const std::vector<Eigen::Index>& indices, const size_t firstIdx, const Eigen::Index rowsNo, Eigen::Ref<Matrix> batch) const
         {
-            std::random_device randDevice;
-            std::seed_seq rngSeed{randDevice(), randDevice(), randDevice(), randDevice(), randDevice(), randDevice(), randDevice(), randDevice()};
+            const Eigen::Index colsNo = data.cols();
+            const Eigen::Index dataStride = data.outerStride();
 
-            // Create random engines with the rng seed
-            std::mt19937 engine(rngSeed);
+            // plain loops, Eigen expression per data row costs more than the copy of a few values
+            for(Eigen::Index i = 0; i < rowsNo; ++i)
+            {
+                const Scalar* dataRow = data.data() + indices[firstIdx + i];
+                Scalar* batchCol = batch.col(i).data();
+
+                for(Eigen::Index j = 0; j < colsNo; ++j)
+                {
+                    batchCol[j] = dataRow[j * dataStride];
+                }
+            }
+        }
+
+        // Gather data rows and scale them on the fly, each value is written once already scaled
+        void DataHandler::gatherRows(const Matrix& data, const std::vector<Eigen::Index>& indices, const size_t firstIdx, const Eigen::Index rowsNo, 
+                                     const Scaler::Scaler& scaler, Eigen::Ref<Matrix> batch) const
+        {
+            const Eigen::Index colsNo = data.cols();
+            const Eigen::Index dataStride = data.outerStride();
+            const Scalar* offset = scaler.get_mOffset().data();
+            const Scalar* scale = scaler.get_mScale().data();
+
+            if(colsNo != scaler.get_mOffset().size())
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Number of data columns does not match the scaler!");
+            }
+
+            for(Eigen::Index i = 0; i < rowsNo; ++i)
+            {
+                const Scalar* dataRow = data.data() + indices[firstIdx + i];
+                Scalar* batchCol = batch.col(i).data();
+
+                for(Eigen::Index j = 0; j < colsNo; ++j)
+                {
+                    batchCol[j] = (dataRow[j * dataStride] - offset[j]) * scale[j];
+                }
+            }
+        }
+
+        // Split [begin, end) into chunksNo chunks of about the same size at line boundaries
+        std::vector<const char*> DataHandler::splitData(const char* begin, const char* end, const size_t chunksNo) const
+        {
+            const size_t size = static_cast<size_t>(end - begin);
+            std::vector<const char*> chunkBounds(chunksNo + 1U, end);
+
+            chunkBounds[0] = begin;
+            for(size_t i = 1; i < chunksNo; ++i)
+            {
+                const char* bound = std::max(begin + ((size / chunksNo) * i), chunkBounds[i - 1]);
+                chunkBounds[i] = std::min(findLineEnd(bound, end) + 1, end);
+            }
+
+            return chunkBounds;
+        }
+
+        // Number of values in the first data row of [begin, end), 0 if there is no data row
+        Eigen::Index DataHandler::countDataColumns(const char* begin, const char* end) const
+        {
+            while(begin < end)
+            {
+                const char* lineEnd = findLineEnd(begin, end);
+
+                if(true == isDataLine(begin, lineEnd))
+                {
+                    return countValues(begin, lineEnd);
+                }
+
+                begin = lineEnd + 1;
+            }
 
-            // Create permutation Matrix with the size of the rows
-            Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic> permMat(inData.rows());
+            return 0;
+        }
+
+        // Number of data rows in [begin, end)
+        Eigen::Index DataHandler::countDataRows(const char* begin, const char* end) const
+        {
+            return countDataLines(begin, end);
+        }
+
+        // Parse data rows of [begin, end) into the rows of inData and expData starting at rowIdx
+        void DataHandler::parseDataRows(const char* begin, const char* end, const Eigen::Index rowIdx, Matrix& inData, Matrix& expData) const
+        {
+            parseDataLines(begin, end, rowIdx, inData, expData);
+        }
+
+        // Load data from the text file into a Matrix
+        Matrix DataHandler::loadData(const std::string& path, const uint16_t threadsNo)
+        {
+            Matrix data;
+            Matrix unused;
 
-            permMat.setIdentity();
+            parseDataFile(path, threadsNo, NNFRAMEWORK_ZERO, NNFRAMEWORK_ZERO, data, unused);
+
+            return data;
+        }
+
+        // Load data from the text file and split each data row into input data and expected data
+        std::tuple<Matrix, Matrix> DataHandler::loadData(const std::string& path, const uint32_t inCol, const uint32_t expCol, const uint16_t threadsNo)
+        {
+            if(NNFRAMEWORK_ZERO == inCol)
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Number of input data columns must be greater than zero!");
+            }
+
+            Matrix inData;
+            Matrix expData;
+
+            parseDataFile(path, threadsNo, inCol, expCol, inData, expData);
+
+            return std::make_tuple(std::move(inData), std::move(expData));
+        }
+
+        // Parse data rows of the text file into inData and expData
+        // the file is parsed in two passes over the same chunks:
+        // 1) data lines of each chunk are counted, so each chunk knows its first row and matrices are allocated once
+        // 2) values of each chunk are parsed with std::from_chars() directly into the matrices
+        void DataHandler::parseDataFile(const std::string& path, const uint16_t threadsNo, const uint32_t inCol, const uint32_t expCol, Matrix& inData, Matrix& expData) const
+        {
+            MappedFile::MappedFile dataFile(path, MappedFile::MapMode::READ_ONLY);
+
+            if(nullptr == dataFile.data())
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Data file " + path + " is empty!");
+            }
+
+            const char* begin = reinterpret_cast<const char*>(dataFile.data());
+            const char* end = begin + dataFile.size();
+
+            // number of columns is taken from the first data line
+            const Eigen::Index colsNo = countDataColumns(begin, end);
+            if(NNFRAMEWORK_ZERO == colsNo)
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Data file " + path + " holds no data!");
+            }
+            if((NNFRAMEWORK_ZERO != inCol) && (colsNo != static_cast<Eigen::Index>(inCol + expCol)))
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Data file " + path + " holds " + std::to_string(colsNo) + " values per data row instead of " + std::to_string(inCol + expCol) + "!");
+            }
+
+            // split the file into chunks at line boundaries
+            const size_t hardwareThreadsNo = std::max(1U, std::thread::hardware_concurrency());
+            const size_t maxChunksNo = std::max<size_t>(1U, dataFile.size() / LOAD_CHUNK_MIN_SIZE);
+            const size_t chunksNo = std::min<size_t>((NNFRAMEWORK_ZERO == threadsNo) ? hardwareThreadsNo : threadsNo, maxChunksNo);
+
+            const std::vector<const char*> chunkBounds = splitData(begin, end, chunksNo);
+
+            std::vector<Eigen::Index> chunkRows(chunksNo + 1U, 0);
+            std::vector<std::exception_ptr> errors(chunksNo);
+
+            // run job on every chunk, first chunk is processed by the calling thread
+            auto runChunks = [&](auto job)
+            {
+                std::vector<std::jthread> threads;
+                threads.reserve(chunksNo - 1U);
+
+                auto runChunk = [&](const size_t chunkIdx)
+                {
+                    try
+                    {
+                        job(chunkIdx);
+                    }
+                    catch(...)
+                    {
+                        errors[chunkIdx] = std::current_exception();
+                    }
+                };
+
+                for(size_t i = 1; i < chunksNo; ++i)
+                {
+                    threads.emplace_back(runChunk, i);
+                }
+                runChunk(0U);
+
+                threads.clear();
+
+                for(const std::exception_ptr& error : errors)
+                {
+                    if(nullptr != error)
+                    {
+                        std::rethrow_exception(error);
+                    }
+                }
+            };
+
+            // 1) count data lines of each chunk
+            runChunks([&](const size_t chunkIdx) { chunkRows[chunkIdx + 1U] = countDataLines(chunkBounds[chunkIdx], chunkBounds[chunkIdx + 1U]); });
+
+            // first row of each chunk
+            for(size_t i = 1; i <= chunksNo; ++i)
+            {
+                chunkRows[i] += chunkRows[i - 1U];
+            }
 
-            std::shuffle(permMat.indices().data(), permMat.indices().data() + permMat.indices().size(), engine);
+            const Eigen::Index inColsNo = (NNFRAMEWORK_ZERO == inCol) ? colsNo : static_cast<Eigen::Index>(inCol);
+            inData.resize(chunkRows[chunksNo], inColsNo);
+            expData.resize(chunkRows[chunksNo], colsNo - inColsNo);
 
-            inData = permMat * inData;   // Shuffle row wise
-            expData = permMat * expData; // Shuffle row wise
+            // 2) parse data lines of each chunk
+            runChunks([&](const size_t chunkIdx) { parseDataLines(chunkBounds[chunkIdx], chunkBounds[chunkIdx + 1U], chunkRows[chunkIdx], inData, expData); });
         }
     }
 }
\ No newline at end of file
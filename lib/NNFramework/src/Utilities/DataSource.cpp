@@ -0,0 +1,515 @@
+#include "Utilities/DataSource.hpp"
+#include "Utilities/DataHandler.hpp"
+#include <iostream>
+#include <numeric>
+#include <algorithm>
+
+namespace NNFramework
+{
+    namespace DataSource
+    {
+        // Check if batch matrices match the data source
+        static void checkBatchDim(const std::string fName, const DataSource& source, const Eigen::Ref<Matrix>& inBatch, const Eigen::Ref<Matrix>& expBatch)
+        {
+            if((inBatch.rows() != source.inputColsNo()) || (expBatch.rows() != source.expectedColsNo()) || (inBatch.cols() != expBatch.cols()))
+            {
+                std::cout << fName << ": ";
+                throw std::runtime_error("Batch matrices do not match the data source!");
+            }
+        }
+
+        // Gather data rows into the batch, scaled by the scaler if it is set
+        static void gatherRows(const Matrix& data, const std::vector<Eigen::Index>& rowsOrder, const size_t firstRow, const Eigen::Index rowsNo, 
+                               const Scaler::Scaler* scaler, Eigen::Ref<Matrix> batch)
+        {
+            const std::unique_ptr<DataHandler::DataHandler>& dHandler = DataHandler::DataHandler::getInstance();
+
+            if(nullptr != scaler)
+            {
+                dHandler->gatherRows(data, rowsOrder, firstRow, rowsNo, *scaler, batch);
+            }
+            else
+            {
+                dHandler->gatherRows(data, rowsOrder, firstRow, rowsNo, batch);
+            }
+        }
+
+        void DataSource::setScalers(const Scaler::Scaler* inScaler, const Scaler::Scaler* expScaler)
+        {
+            if(((nullptr != inScaler) && (inScaler->get_mColumnsNo() != inputColsNo())) || 
+               ((nullptr != expScaler) && (expScaler->get_mColumnsNo() != expectedColsNo())))
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Scalers do not match the data rows of " + name() + "!");
+            }
+
+            mInScaler = inScaler;
+            mExpScaler = expScaler;
+        }
+
+        // Scale the batches by the scalers
+        void DataSource::scaleBatch(Eigen::Ref<Matrix> inBatch, Eigen::Ref<Matrix> expBatch) const
+        {
+            if(nullptr != mInScaler)
+            {
+                mInScaler->transformBatch(inBatch);
+            }
+
+            if(nullptr != mExpScaler)
+            {
+                mExpScaler->transformBatch(expBatch);
+            }
+        }
+
+        MatrixDataSource::MatrixDataSource(const Matrix& inData, const Matrix& expData) : 
+            mInData(inData), mExpData(expData), mRowsOrder(static_cast<size_t>(inData.rows())), mNextRow(0U), mEngine(Random::nextSeed())
+        {
+            if(inData.rows() != expData.rows())
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Input data and expected data do not have the same number of rows!");
+            }
+
+            std::iota(mRowsOrder.begin(), mRowsOrder.end(), 0);
+        }
+
+        void MatrixDataSource::reset(const bool shuffle)
+        {
+            if(true == shuffle)
+            {
+                DataHandler::DataHandler::getInstance()->shuffleIndices(mRowsOrder, mEngine);
+            }
+
+            mNextRow = 0U;
+        }
+
+        uint32_t MatrixDataSource::nextBatch(Eigen::Ref<Matrix> inBatch, Eigen::Ref<Matrix> expBatch)
+        {
+            checkBatchDim(__FUNCTION__, *this, inBatch, expBatch);
+
+            const Eigen::Index batchRows = std::min<Eigen::Index>(inBatch.cols(), static_cast<Eigen::Index>(mRowsOrder.size() - mNextRow));
+
+            gatherRows(mInData, mRowsOrder, mNextRow, batchRows, mInScaler, inBatch);
+            gatherRows(mExpData, mRowsOrder, mNextRow, batchRows, mExpScaler, expBatch);
+            mNextRow += static_cast<size_t>(batchRows);
+
+            return static_cast<uint32_t>(batchRows);
+        }
+
+        BlockDataSource::BlockDataSource() : 
+            mEpochRowsNo(0U), mNextBlock(0U), mLoadedBlock(NO_BLOCK), mNextRow(0U), mRowsTaken(0U), mShuffled(false), mEpochSeed(0U), mEngine(Random::nextSeed())
+        {
+        }
+
+        void BlockDataSource::reset(const bool shuffle)
+        {
+            // blocks are taken in the stored order until the first shuffle
+            if(mBlocksOrder.size() != blocksNo())
+            {
+                mBlocksOrder.resize(blocksNo());
+                std::iota(mBlocksOrder.begin(), mBlocksOrder.end(), 0);
+            }
+
+            if(true == shuffle)
+            {
+                DataHandler::DataHandler::getInstance()->shuffleIndices(mBlocksOrder, mEngine);
+                mEpochSeed = mEngine();
+                mShuffled = true;
+            }
+
+            mNextBlock = 0U;
+            mRowsOrder.clear();
+            mNextRow = 0U;
+            mRowsTaken = 0U;
+        }
+
+        uint32_t BlockDataSource::nextBatch(Eigen::Ref<Matrix> inBatch, Eigen::Ref<Matrix> expBatch)
+        {
+            checkBatchDim(__FUNCTION__, *this, inBatch, expBatch);
+
+            Eigen::Index batchRows = 0;
+
+            // batch may span multiple blocks
+            while(batchRows < inBatch.cols())
+            {
+                if(mNextRow >= mRowsOrder.size())
+                {
+                    if(mNextBlock >= mBlocksOrder.size())
+                    {
+                        // end of the epoch
+                        mEpochRowsNo = mRowsTaken + static_cast<uint64_t>(batchRows);
+                        break;
+                    }
+
+                    startBlock(static_cast<size_t>(mBlocksOrder[mNextBlock++]));
+                    continue;
+                }
+
+                const Eigen::Index rowsNo = std::min<Eigen::Index>(inBatch.cols() - batchRows, static_cast<Eigen::Index>(mRowsOrder.size() - mNextRow));
+
+                gatherRows(mInBlock, mRowsOrder, mNextRow, rowsNo, mInScaler, inBatch.middleCols(batchRows, rowsNo));
+                gatherRows(mExpBlock, mRowsOrder, mNextRow, rowsNo, mExpScaler, expBatch.middleCols(batchRows, rowsNo));
+
+                mNextRow += static_cast<size_t>(rowsNo);
+                batchRows += rowsNo;
+            }
+
+            mRowsTaken += static_cast<uint64_t>(batchRows);
+
+            return static_cast<uint32_t>(batchRows);
+        }
+
+        // Load the block if it is not loaded yet and set up the order of its data rows
+        void BlockDataSource::startBlock(const size_t blockIdx)
+        {
+            // data that fits into a single block is loaded only once
+            if(blockIdx != mLoadedBlock)
+            {
+                loadBlock(blockIdx, mInBlock, mExpBlock);
+                mLoadedBlock = blockIdx;
+            }
+
+            mRowsOrder.resize(static_cast<size_t>(mInBlock.rows()));
+            std::iota(mRowsOrder.begin(), mRowsOrder.end(), 0);
+
+            // rows order of each block depends only on the epoch seed, thus it is kept until the next shuffle
+            if(true == mShuffled)
+            {
+                Random::Xoshiro256 blockEngine(mEpochSeed + blockIdx);
+                DataHandler::DataHandler::getInstance()->shuffleIndices(mRowsOrder, blockEngine);
+            }
+
+            mNextRow = 0U;
+        }
+
+        DatasetDataSource::DatasetDataSource(const Dataset::Dataset& dataset, const std::vector<std::string>& inColumns, const std::vector<std::string>& expColumns,
+                                             const uint64_t blockRows) : 
+            mDataset(dataset), mBlockRows(blockRows)
+        {
+            if(NNFRAMEWORK_ZERO == blockRows)
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Block size must be greater than zero!");
+            }
+
+            for(const std::string& column : inColumns)
+            {
+                mInColumnsIdx.push_back(dataset.columnIdx(column));
+            }
+
+            for(const std::string& column : expColumns)
+            {
+                mExpColumnsIdx.push_back(dataset.columnIdx(column));
+            }
+        }
+
+        size_t DatasetDataSource::blocksNo() const
+        {
+            return static_cast<size_t>((mDataset.get_mRowsNo() + mBlockRows - 1U) / mBlockRows);
+        }
+
+        void DatasetDataSource::loadBlock(const size_t blockIdx, Matrix& inBlock, Matrix& expBlock)
+        {
+            const uint64_t firstRow = static_cast<uint64_t>(blockIdx) * mBlockRows;
+            const Eigen::Index rowsNo = static_cast<Eigen::Index>(std::min(mBlockRows, mDataset.get_mRowsNo() - firstRow));
+
+            inBlock.resize(rowsNo, static_cast<Eigen::Index>(mInColumnsIdx.size()));
+            expBlock.resize(rowsNo, static_cast<Eigen::Index>(mExpColumnsIdx.size()));
+
+            mDataset.gatherColumns(mInColumnsIdx, firstRow, inBlock);
+            mDataset.gatherColumns(mExpColumnsIdx, firstRow, expBlock);
+        }
+
+        TextDataSource::TextDataSource(const std::string& path, const uint32_t inCol, const uint32_t expCol, const size_t chunkSize) : 
+            mDataFilePtr(std::make_unique<MappedFile::MappedFile>(path, MappedFile::MapMode::READ_ONLY)), mInCol(inCol), mExpCol(expCol)
+        {
+            std::unique_ptr<DataHandler::DataHandler>& dHandleRef = DataHandler::DataHandler::getInstance();
+
+            if((NNFRAMEWORK_ZERO == inCol) || (NNFRAMEWORK_ZERO == chunkSize))
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Number of input data columns and chunk size must be greater than zero!");
+            }
+
+            if(nullptr == mDataFilePtr->data())
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Data file " + path + " is empty!");
+            }
+
+            const char* begin = reinterpret_cast<const char*>(mDataFilePtr->data());
+            const char* end = begin + mDataFilePtr->size();
+
+            // number of columns is checked on the first data row, the rest is checked while the chunks are parsed
+            if(dHandleRef->countDataColumns(begin, end) != static_cast<Eigen::Index>(inCol + expCol))
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Data file " + path + " does not hold " + std::to_string(inCol + expCol) + " values per data row!");
+            }
+
+            mChunkBounds = dHandleRef->splitData(begin, end, std::max<size_t>(1U, mDataFilePtr->size() / chunkSize));
+        }
+
+        size_t TextDataSource::blocksNo() const
+        {
+            return mChunkBounds.size() - 1U;
+        }
+
+        void TextDataSource::loadBlock(const size_t blockIdx, Matrix& inBlock, Matrix& expBlock)
+        {
+            std::unique_ptr<DataHandler::DataHandler>& dHandleRef = DataHandler::DataHandler::getInstance();
+
+            const Eigen::Index rowsNo = dHandleRef->countDataRows(mChunkBounds[blockIdx], mChunkBounds[blockIdx + 1U]);
+
+            inBlock.resize(rowsNo, mInCol);
+            expBlock.resize(rowsNo, mExpCol);
+
+            dHandleRef->parseDataRows(mChunkBounds[blockIdx], mChunkBounds[blockIdx + 1U], 0, inBlock, expBlock);
+        }
+
+        GeneratorDataSource::GeneratorDataSource(Generator generator, const uint32_t inputColsNo, const uint32_t expectedColsNo, const uint64_t rowsPerEpoch) : 
+            mGenerator(std::move(generator)), mInputColsNo(inputColsNo), mExpectedColsNo(expectedColsNo), mRowsPerEpoch(rowsPerEpoch), mRowsTaken(0U)
+        {
+            if(nullptr == mGenerator)
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Generator is not provided!");
+            }
+        }
+
+        // generated data rows have no order to shuffle
+        void GeneratorDataSource::reset(const bool)
+        {
+            mRowsTaken = 0U;
+        }
+
+        uint32_t GeneratorDataSource::nextBatch(Eigen::Ref<Matrix> inBatch, Eigen::Ref<Matrix> expBatch)
+        {
+            checkBatchDim(__FUNCTION__, *this, inBatch, expBatch);
+
+            // last batch of the epoch is limited to the remaining rows
+            Eigen::Index batchRows = inBatch.cols();
+            if(NNFRAMEWORK_ZERO != mRowsPerEpoch)
+            {
+                batchRows = static_cast<Eigen::Index>(std::min<uint64_t>(static_cast<uint64_t>(batchRows), mRowsPerEpoch - mRowsTaken));
+            }
+
+            if(NNFRAMEWORK_ZERO == batchRows)
+            {
+                return 0U;
+            }
+
+            const uint32_t generatedRows = mGenerator(inBatch.leftCols(batchRows), expBatch.leftCols(batchRows));
+            if(generatedRows > batchRows)
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Generator returned more data rows than requested!");
+            }
+
+            scaleBatch(inBatch.leftCols(generatedRows), expBatch.leftCols(generatedRows));
+            mRowsTaken += generatedRows;
+
+            return generatedRows;
+        }
+
+        PrefetchDataSource::PrefetchDataSource(DataSource& source, const uint32_t prefetchDepth, Transform transform) : 
+            mSource(source), mTransform(std::move(transform)), mQueue(prefetchDepth), mRowsNo(source.rowsNo()), mEpochRequested(false), mStop(false), 
+            mCancel(false), mBatchCols(0), mEpochRunning(false), mEpochDone(false)
+        {
+            if(NNFRAMEWORK_ZERO == prefetchDepth)
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Prefetch depth must be greater than zero!");
+            }
+
+            mProducerThread = std::thread(&PrefetchDataSource::producerLoop, this);
+        }
+
+        // Stop the producer thread
+        PrefetchDataSource::~PrefetchDataSource()
+        {
+            cancelEpoch();
+
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mStop = true;
+            }
+            mCv.notify_one();
+
+            mProducerThread.join();
+        }
+
+        void PrefetchDataSource::reset(const bool shuffle)
+        {
+            // wrapped data source may be used only while the producer is idle
+            cancelEpoch();
+
+            mSource.reset(shuffle);
+            mEpochDone = false;
+
+            // batch size is known since the first epoch, producer can start right away
+            if(NNFRAMEWORK_ZERO != mBatchCols)
+            {
+                startEpoch(mBatchCols);
+            }
+        }
+
+        uint32_t PrefetchDataSource::nextBatch(Eigen::Ref<Matrix> inBatch, Eigen::Ref<Matrix> expBatch)
+        {
+            checkBatchDim(__FUNCTION__, *this, inBatch, expBatch);
+
+            if(false == mEpochRunning)
+            {
+                if(true == mEpochDone)
+                {
+                    return 0U;
+                }
+
+                startEpoch(inBatch.cols());
+            }
+            else if(inBatch.cols() != mBatchCols)
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Number of requested data rows changed during the epoch!");
+            }
+
+            Batch& batch = mQueue.acquireFront();
+            const uint32_t batchRows = batch.rows;
+            const std::exception_ptr error = batch.error;
+
+            if(NNFRAMEWORK_ZERO != batchRows)
+            {
+                inBatch.leftCols(batchRows) = batch.inBatch.leftCols(batchRows);
+                expBatch.leftCols(batchRows) = batch.expBatch.leftCols(batchRows);
+            }
+            mQueue.releaseFront();
+
+            if(NNFRAMEWORK_ZERO == batchRows)
+            {
+                // producer is idle after the end of the epoch
+                mEpochRunning = false;
+                mEpochDone = true;
+            }
+
+            if(nullptr != error)
+            {
+                std::rethrow_exception(error);
+            }
+
+            return batchRows;
+        }
+
+        // Scalers are set on the wrapped data source
+        void PrefetchDataSource::setScalers(const Scaler::Scaler* inScaler, const Scaler::Scaler* expScaler)
+        {
+            mSource.setScalers(inScaler, expScaler);
+        }
+
+        // Start producing batches of batchCols data rows for the current epoch
+        void PrefetchDataSource::startEpoch(const Eigen::Index batchCols)
+        {
+            // producer is idle, batch buffers can be resized
+            if(batchCols != mBatchCols)
+            {
+                for(Batch& batch : mQueue.slots())
+                {
+                    batch.inBatch.resize(mSource.inputColsNo(), batchCols);
+                    batch.expBatch.resize(mSource.expectedColsNo(), batchCols);
+                }
+                mBatchCols = batchCols;
+            }
+
+            mCancel.store(false, std::memory_order_relaxed);
+
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mEpochRequested = true;
+            }
+            mCv.notify_one();
+
+            mEpochRunning = true;
+        }
+
+        // End current epoch of the producer, prefetched batches are dropped
+        void PrefetchDataSource::cancelEpoch()
+        {
+            if(true == mEpochRunning)
+            {
+                mCancel.store(true, std::memory_order_relaxed);
+
+                // producer always ends the epoch with an empty batch
+                while(true)
+                {
+                    Batch& batch = mQueue.acquireFront();
+                    const bool epochEnd = (NNFRAMEWORK_ZERO == batch.rows);
+                    mQueue.releaseFront();
+
+                    if(true == epochEnd)
+                    {
+                        break;
+                    }
+                }
+
+                mEpochRunning = false;
+            }
+        }
+
+        // Producer thread loop
+        void PrefetchDataSource::producerLoop()
+        {
+            while(true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mMutex);
+                    mCv.wait(lock, [this]() { return (true == mStop) || (true == mEpochRequested); });
+
+                    if(true == mStop)
+                    {
+                        break;
+                    }
+
+                    mEpochRequested = false;
+                }
+
+                // fill free batch buffers until the end of the epoch
+                while(true)
+                {
+                    Batch& batch = mQueue.acquireBack();
+                    batch.rows = 0U;
+                    batch.error = nullptr;
+
+                    if(false == mCancel.load(std::memory_order_relaxed))
+                    {
+                        try
+                        {
+                            batch.rows = mSource.nextBatch(batch.inBatch, batch.expBatch);
+
+                            if((NNFRAMEWORK_ZERO != batch.rows) && (nullptr != mTransform))
+                            {
+                                mTransform(batch.inBatch.leftCols(batch.rows), batch.expBatch.leftCols(batch.rows));
+                            }
+                        }
+                        catch(...)
+                        {
+                            batch.rows = 0U;
+                            batch.error = std::current_exception();
+                        }
+                    }
+
+                    const bool epochEnd = (NNFRAMEWORK_ZERO == batch.rows);
+                    if(true == epochEnd)
+                    {
+                        mRowsNo.store(mSource.rowsNo(), std::memory_order_relaxed);
+                    }
+
+                    mQueue.commitBack();
+
+                    if(true == epochEnd)
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
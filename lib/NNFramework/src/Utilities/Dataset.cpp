@@ -0,0 +1,335 @@
+#include "Utilities/Dataset.hpp"
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <unordered_set>
+#include <cmath>
+
+namespace NNFramework
+{
+    namespace Dataset
+    {
+        // Map all shards of the dataset (<path>.0, <path>.1, ...)
+        Dataset::Dataset(const std::string& path) : mShardFirstRow(1U, 0U)
+        {
+            // number of shards is known after the first shard is read
+            uint32_t shardsNo = 1U;
+
+            for(uint32_t shardIdx = 0; shardIdx < shardsNo; ++shardIdx)
+            {
+                readShard(shardPath(path, shardIdx), shardIdx, shardsNo);
+            }
+        }
+
+        // Convert data into the binary columnar dataset
+        bool Dataset::saveDataset(const std::string& path, const Eigen::Ref<const Matrix>& data, const std::vector<std::string>& columnNames,
+                                  const std::vector<DatasetFile::ColumnRole>& columnRoles, const uint64_t shardRowsNo, const DatasetFile::DataType dataType)
+        {
+            try
+            {
+                if((NNFRAMEWORK_ZERO == data.rows()) || (NNFRAMEWORK_ZERO == data.cols()))
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Data is empty!");
+                }
+
+                if((columnNames.size() != static_cast<size_t>(data.cols())) || (columnRoles.size() != static_cast<size_t>(data.cols())))
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Each data column must have its name and role!");
+                }
+
+                if((DatasetFile::FLOAT32 != dataType) && (DatasetFile::FLOAT64 != dataType))
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Unsupported data type!");
+                }
+
+                std::unordered_set<std::string> uniqueNames;
+                for(const std::string& name : columnNames)
+                {
+                    if((true == name.empty()) || (name.size() >= DatasetFile::COLUMN_NAME_SIZE) || (false == uniqueNames.insert(name).second))
+                    {
+                        std::cout << __FUNCTION__ << ": ";
+                        throw std::runtime_error("Column name " + name + " is empty, too long or not unique!");
+                    }
+                }
+
+                const uint32_t columnsNo = static_cast<uint32_t>(data.cols());
+                const uint64_t rowsNo = static_cast<uint64_t>(data.rows());
+                const uint64_t rowsPerShard = (NNFRAMEWORK_ZERO == shardRowsNo) ? rowsNo : shardRowsNo;
+                const uint32_t shardsNo = static_cast<uint32_t>((rowsNo + rowsPerShard - 1U) / rowsPerShard);
+
+                // column records are the same in every shard, except for the blob offsets
+                std::vector<DatasetFile::ColumnRecord> records(columnsNo);
+                for(uint32_t columnIdx = 0; columnIdx < columnsNo; ++columnIdx)
+                {
+                    DatasetFile::ColumnRecord& record = records[columnIdx];
+                    const Eigen::VectorXd column = data.col(columnIdx).cast<double>();
+
+                    std::strncpy(record.name, columnNames[columnIdx].c_str(), DatasetFile::COLUMN_NAME_SIZE - 1U);
+                    record.role = columnRoles[columnIdx];
+                    record.dataType = dataType;
+                    record.min = column.minCoeff();
+                    record.max = column.maxCoeff();
+                    record.mean = column.mean();
+                    record.stdDev = std::sqrt((column.array() - record.mean).square().mean());
+                }
+
+                for(uint32_t shardIdx = 0; shardIdx < shardsNo; ++shardIdx)
+                {
+                    const uint64_t firstRow = static_cast<uint64_t>(shardIdx) * rowsPerShard;
+                    const uint64_t shardRows = std::min(rowsPerShard, rowsNo - firstRow);
+                    const uint64_t blobSize = shardRows * dataType;
+                    const std::string shardFilePath = shardPath(path, shardIdx);
+
+                    std::ofstream shardFile(shardFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+                    if(false == shardFile.is_open())
+                    {
+                        std::cout << __FUNCTION__ << ": ";
+                        throw std::runtime_error("Dataset shard " + shardFilePath + " cannot be created!");
+                    }
+
+                    // header
+                    DatasetFile::Header header {};
+                    std::memcpy(header.magic, DatasetFile::MAGIC, sizeof(header.magic));
+                    header.version = DatasetFile::VERSION;
+                    header.columnsNo = columnsNo;
+                    header.shardIdx = shardIdx;
+                    header.shardsNo = shardsNo;
+                    header.rowsNo = shardRows;
+                    header.firstRow = firstRow;
+                    header.datasetRowsNo = rowsNo;
+
+                    shardFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+                    // column records, blobs follow each other in the order of the columns
+                    for(uint32_t columnIdx = 0; columnIdx < columnsNo; ++columnIdx)
+                    {
+                        records[columnIdx].dataOffset = DatasetFile::columnsOffset(columnsNo) + (columnIdx * DatasetFile::alignOffset(blobSize));
+                        shardFile.write(reinterpret_cast<const char*>(&records[columnIdx]), sizeof(records[columnIdx]));
+                    }
+
+                    // column blobs, each one padded up to the alignment of the next one
+                    const char padding[DatasetFile::COLUMN_ALIGNMENT] = {};
+                    uint64_t fileEnd = sizeof(header) + (static_cast<uint64_t>(columnsNo) * sizeof(DatasetFile::ColumnRecord));
+
+                    for(uint32_t columnIdx = 0; columnIdx < columnsNo; ++columnIdx)
+                    {
+                        shardFile.write(padding, static_cast<std::streamsize>(records[columnIdx].dataOffset - fileEnd));
+
+                        const auto column = data.col(columnIdx).segment(static_cast<Eigen::Index>(firstRow), static_cast<Eigen::Index>(shardRows));
+                        if(DatasetFile::FLOAT32 == dataType)
+                        {
+                            const Eigen::VectorXf values = column.cast<float>();
+                            shardFile.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(blobSize));
+                        }
+                        else
+                        {
+                            const Eigen::VectorXd values = column.cast<double>();
+                            shardFile.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(blobSize));
+                        }
+
+                        fileEnd = records[columnIdx].dataOffset + blobSize;
+                    }
+
+                    shardFile.flush();
+                    if(false == shardFile.good())
+                    {
+                        std::cout << __FUNCTION__ << ": ";
+                        throw std::runtime_error("Dataset shard " + shardFilePath + " cannot be written!");
+                    }
+                }
+
+                return true;
+            }
+            catch(const std::exception& e)
+            {
+                std::cerr << __FUNCTION__ << ": ";
+                std::cerr << e.what() << std::endl;
+                return false;
+            }
+        }
+
+        // Path of the dataset shard
+        std::string Dataset::shardPath(const std::string& path, const uint32_t shardIdx)
+        {
+            return path + "." + std::to_string(shardIdx);
+        }
+
+        // Index of the column with the given name
+        uint32_t Dataset::columnIdx(const std::string& columnName) const
+        {
+            for(uint32_t columnIdx = 0; columnIdx < mColumns.size(); ++columnIdx)
+            {
+                if(columnName == mColumns[columnIdx].name)
+                {
+                    return columnIdx;
+                }
+            }
+
+            std::cout << __FUNCTION__ << ": ";
+            throw std::runtime_error("Dataset has no column " + columnName + "!");
+        }
+
+        // Names of all columns with the given role, in the stored order
+        std::vector<std::string> Dataset::columnNames(const DatasetFile::ColumnRole role) const
+        {
+            std::vector<std::string> names;
+
+            for(const Column& column : mColumns)
+            {
+                if(role == column.role)
+                {
+                    names.push_back(column.name);
+                }
+            }
+
+            return names;
+        }
+
+        // Copy rows [firstRow, firstRow + out.rows()) of the selected columns into out
+        void Dataset::gatherColumns(const std::vector<uint32_t>& columnsIdx, const uint64_t firstRow, Eigen::Ref<Matrix> out) const
+        {
+            if(columnsIdx.size() != static_cast<size_t>(out.cols()))
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Number of selected columns does not match the output Matrix!");
+            }
+
+            if((firstRow + static_cast<uint64_t>(out.rows())) > get_mRowsNo())
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Selected rows are out of the dataset!");
+            }
+
+            for(const uint32_t columnIdx : columnsIdx)
+            {
+                if(columnIdx >= mColumns.size())
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Selected column is out of the dataset!");
+                }
+            }
+
+            // first shard holding firstRow
+            size_t shardIdx = static_cast<size_t>(std::upper_bound(mShardFirstRow.begin(), mShardFirstRow.end(), firstRow) - mShardFirstRow.begin()) - 1U;
+            Eigen::Index outRow = 0;
+
+            while(outRow < out.rows())
+            {
+                const uint64_t shardRow = (firstRow + static_cast<uint64_t>(outRow)) - mShardFirstRow[shardIdx];
+                const Eigen::Index rowsNo = std::min<Eigen::Index>(out.rows() - outRow, static_cast<Eigen::Index>(mShardFirstRow[shardIdx + 1U] - mShardFirstRow[shardIdx] - shardRow));
+
+                for(size_t i = 0; i < columnsIdx.size(); ++i)
+                {
+                    const uint8_t* columnData = mColumnData[shardIdx][columnsIdx[i]];
+                    auto outColumn = out.col(static_cast<Eigen::Index>(i)).segment(outRow, rowsNo);
+
+                    if(DatasetFile::FLOAT32 == mColumns[columnsIdx[i]].dataType)
+                    {
+                        outColumn = Eigen::Map<const Eigen::VectorXf>(reinterpret_cast<const float*>(columnData) + shardRow, rowsNo).cast<Scalar>();
+                    }
+                    else
+                    {
+                        outColumn = Eigen::Map<const Eigen::VectorXd>(reinterpret_cast<const double*>(columnData) + shardRow, rowsNo).cast<Scalar>();
+                    }
+                }
+
+                outRow += rowsNo;
+                ++shardIdx;
+            }
+        }
+
+        // Copy all rows of the named columns into a new Matrix
+        Matrix Dataset::loadColumns(const std::vector<std::string>& columnNames) const
+        {
+            std::vector<uint32_t> columnsIdx;
+            for(const std::string& name : columnNames)
+            {
+                columnsIdx.push_back(columnIdx(name));
+            }
+
+            Matrix data(static_cast<Eigen::Index>(get_mRowsNo()), static_cast<Eigen::Index>(columnsIdx.size()));
+            gatherColumns(columnsIdx, 0U, data);
+
+            return data;
+        }
+
+        // Validate shard header and column records, record the columns of the first shard
+        void Dataset::readShard(const std::string& shardPath, const uint32_t shardIdx, uint32_t& shardsNo)
+        {
+            std::unique_ptr<MappedFile::MappedFile> shardPtr = std::make_unique<MappedFile::MappedFile>(shardPath, MappedFile::MapMode::READ_ONLY);
+
+            DatasetFile::Header header {};
+            if(shardPtr->size() < sizeof(header))
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Dataset shard " + shardPath + " is too small!");
+            }
+            std::memcpy(&header, shardPtr->data(), sizeof(header));
+
+            if((0 != std::memcmp(header.magic, DatasetFile::MAGIC, sizeof(header.magic))) || (DatasetFile::VERSION != header.version))
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error(shardPath + " is not a supported dataset shard!");
+            }
+
+            // first shard describes the whole dataset
+            if(NNFRAMEWORK_ZERO == shardIdx)
+            {
+                shardsNo = header.shardsNo;
+            }
+
+            if((header.shardIdx != shardIdx) || (header.shardsNo != shardsNo) || (header.firstRow != mShardFirstRow.back()) ||
+               ((NNFRAMEWORK_ZERO != shardIdx) && (header.columnsNo != mColumns.size())) ||
+               ((header.firstRow + header.rowsNo) > header.datasetRowsNo) || (((shardIdx + 1U) == shardsNo) && ((header.firstRow + header.rowsNo) != header.datasetRowsNo)))
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Dataset shard " + shardPath + " does not belong to the dataset!");
+            }
+
+            if(shardPtr->size() < DatasetFile::columnsOffset(header.columnsNo))
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Dataset shard " + shardPath + " is too small!");
+            }
+
+            std::vector<const uint8_t*> columnData(header.columnsNo);
+            for(uint32_t columnIdx = 0; columnIdx < header.columnsNo; ++columnIdx)
+            {
+                DatasetFile::ColumnRecord record {};
+                std::memcpy(&record, shardPtr->data() + sizeof(header) + (columnIdx * sizeof(record)), sizeof(record));
+                record.name[DatasetFile::COLUMN_NAME_SIZE - 1U] = '\0';
+
+                if(((DatasetFile::FLOAT32 != record.dataType) && (DatasetFile::FLOAT64 != record.dataType)) ||
+                   (NNFRAMEWORK_ZERO != (record.dataOffset % DatasetFile::COLUMN_ALIGNMENT)) ||
+                   ((record.dataOffset + (header.rowsNo * record.dataType)) > shardPtr->size()))
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Dataset shard " + shardPath + " holds an invalid column " + record.name + "!");
+                }
+
+                const Column column { record.name, static_cast<DatasetFile::ColumnRole>(record.role), static_cast<DatasetFile::DataType>(record.dataType),
+                                      ColumnStats { record.min, record.max, record.mean, record.stdDev } };
+
+                if(NNFRAMEWORK_ZERO == shardIdx)
+                {
+                    mColumns.push_back(column);
+                }
+                else if((column.name != mColumns[columnIdx].name) || (column.dataType != mColumns[columnIdx].dataType))
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Dataset shard " + shardPath + " does not belong to the dataset!");
+                }
+
+                columnData[columnIdx] = shardPtr->data() + record.dataOffset;
+            }
+
+            mColumnData.push_back(std::move(columnData));
+            mShardFirstRow.push_back(header.firstRow + header.rowsNo);
+            mShards.push_back(std::move(shardPtr));
+        }
+    }
+}
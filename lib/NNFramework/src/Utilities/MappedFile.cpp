@@ -0,0 +1,105 @@
+#include "Utilities/MappedFile.hpp"
+#include <iostream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace NNFramework
+{
+    namespace MappedFile
+    {
+        // Map the whole file
+        MappedFile::MappedFile(const std::string& path, const MapMode mode) : mData(nullptr), mSize(0), mMode(mode)
+        {
+#ifdef _WIN32
+            HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if(INVALID_HANDLE_VALUE == file)
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("File " + path + " cannot be opened!");
+            }
+
+            LARGE_INTEGER fileSize;
+            if(0 == GetFileSizeEx(file, &fileSize))
+            {
+                CloseHandle(file);
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Size of the file " + path + " cannot be retrieved!");
+            }
+            mSize = static_cast<size_t>(fileSize.QuadPart);
+
+            if(0U != mSize)
+            {
+                // copy-on-write pages are backed by the page file once written
+                HANDLE mapping = CreateFileMappingA(file, nullptr, (MapMode::READ_ONLY == mode) ? PAGE_READONLY : PAGE_WRITECOPY, 0, 0, nullptr);
+                if(nullptr != mapping)
+                {
+                    mData = static_cast<uint8_t*>(MapViewOfFile(mapping, (MapMode::READ_ONLY == mode) ? FILE_MAP_READ : FILE_MAP_COPY, 0, 0, 0));
+
+                    // view keeps the mapping alive
+                    CloseHandle(mapping);
+                }
+            }
+
+            CloseHandle(file);
+#else
+            int fd = open(path.c_str(), O_RDONLY);
+            if(-1 == fd)
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("File " + path + " cannot be opened!");
+            }
+
+            struct stat fileStat;
+            if(-1 == fstat(fd, &fileStat))
+            {
+                close(fd);
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Size of the file " + path + " cannot be retrieved!");
+            }
+            mSize = static_cast<size_t>(fileStat.st_size);
+
+            if(0U != mSize)
+            {
+                // MAP_PRIVATE -> written pages are private copies, the file itself is never modified
+                const int protection = (MapMode::READ_ONLY == mode) ? PROT_READ : (PROT_READ | PROT_WRITE);
+                void* mapped = mmap(nullptr, mSize, protection, MAP_PRIVATE, fd, 0);
+
+                mData = (MAP_FAILED == mapped) ? nullptr : static_cast<uint8_t*>(mapped);
+            }
+
+            // mapping stays valid after the file descriptor is closed
+            close(fd);
+#endif
+
+            if((0U != mSize) && (nullptr == mData))
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("File " + path + " cannot be mapped into memory!");
+            }
+        }
+
+        // Unmap the file
+        MappedFile::~MappedFile()
+        {
+            if(nullptr != mData)
+            {
+#ifdef _WIN32
+                UnmapViewOfFile(mData);
+#else
+                munmap(mData, mSize);
+#endif
+            }
+        }
+    }
+}
@@ -0,0 +1,241 @@
+#include "Utilities/Random.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <mutex>
+#include <numbers>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace NNFramework
+{
+    namespace Random
+    {
+        // Minimum number of blocks generated by one thread of fillUniform() and fillNormal()
+        static constexpr size_t FILL_THREAD_MIN_BLOCKS = 16U;
+
+        // Global seed and the number of streams taken by nextSeed()
+        struct GlobalSeed final
+        {
+            std::mutex mutex;
+            uint64_t seed;
+            uint64_t nextStreamIdx;
+        };
+
+        // Global seed is constructed on the first use, thus it is valid during the static initialization as well
+        static GlobalSeed& getGlobalSeed()
+        {
+            static GlobalSeed globalSeed { {}, (static_cast<uint64_t>(std::random_device{}()) << 32U) | std::random_device{}(), 0U };
+
+            return globalSeed;
+        }
+
+        void setGlobalSeed(const uint64_t seed)
+        {
+            GlobalSeed& globalSeed = getGlobalSeed();
+            std::lock_guard<std::mutex> lock(globalSeed.mutex);
+
+            globalSeed.seed = seed;
+            globalSeed.nextStreamIdx = 0U;
+        }
+
+        uint64_t globalSeed()
+        {
+            GlobalSeed& globalSeed = getGlobalSeed();
+            std::lock_guard<std::mutex> lock(globalSeed.mutex);
+
+            return globalSeed.seed;
+        }
+
+        // Seed of the next stream of the global seed
+        uint64_t nextSeed()
+        {
+            GlobalSeed& globalSeed = getGlobalSeed();
+            std::lock_guard<std::mutex> lock(globalSeed.mutex);
+
+            return mixSeed(globalSeed.seed, globalSeed.nextStreamIdx++);
+        }
+
+        // Random engine of the stream streamIdx of the global seed
+        Xoshiro256 stream(const uint64_t streamIdx)
+        {
+            // streams of nextSeed() are numbered from 0, these are numbered from the other end
+            return Xoshiro256(mixSeed(globalSeed(), ~streamIdx));
+        }
+
+        // FILL_LANES_NO xoshiro256** engines stepped in lockstep
+        // state is stored lane-wise and the multiplications are written as shifts and additions,
+        // thus every step is a handful of vector instructions
+        class LanesEngine final
+        {
+            public:
+                explicit LanesEngine(uint64_t seed)
+                {
+                    for(size_t l = 0; l < FILL_LANES_NO; ++l)
+                    {
+                        mS0[l] = splitMix64(seed);
+                        mS1[l] = splitMix64(seed);
+                        mS2[l] = splitMix64(seed);
+                        mS3[l] = splitMix64(seed);
+                    }
+                }
+
+                // Next value of every lane
+                void next(uint64_t (&values)[FILL_LANES_NO])
+                {
+                    for(size_t l = 0; l < FILL_LANES_NO; ++l)
+                    {
+                        // rotl(s1 * 5, 7) * 9
+                        const uint64_t x = rotl((mS1[l] << 2U) + mS1[l], 7U);
+                        values[l] = (x << 3U) + x;
+
+                        const uint64_t t = mS1[l] << 17U;
+
+                        mS2[l] ^= mS0[l];
+                        mS3[l] ^= mS1[l];
+                        mS1[l] ^= mS2[l];
+                        mS0[l] ^= mS3[l];
+                        mS2[l] ^= t;
+                        mS3[l] = rotl(mS3[l], 45U);
+                    }
+                }
+
+            private:
+                alignas(64) uint64_t mS0[FILL_LANES_NO];
+                alignas(64) uint64_t mS1[FILL_LANES_NO];
+                alignas(64) uint64_t mS2[FILL_LANES_NO];
+                alignas(64) uint64_t mS3[FILL_LANES_NO];
+
+                static constexpr uint64_t rotl(const uint64_t x, const unsigned k)
+                {
+                    return (x << k) | (x >> (64U - k));
+                }
+        };
+
+        // Uniform value in [0, 1) from the upper bits of x
+        // mantissa bits are set directly ([1, 2) - 1), integer to floating point conversion is not needed
+        template<class T>
+        static inline T toUnit(const uint64_t x)
+        {
+            if constexpr (std::is_same_v<T, float>)
+            {
+                return std::bit_cast<float>(static_cast<uint32_t>(0x3F800000U | (x >> 41U))) - 1.0F;
+            }
+            else
+            {
+                return std::bit_cast<double>(0x3FF0000000000000ULL | (x >> 12U)) - 1.0;
+            }
+        }
+
+        // Generate blocks of values of out, block is generated by blockFill(values, valuesNo, blockSeed)
+        template<class BlockFill>
+        static void fillBlocks(Eigen::Ref<Matrix> out, const uint64_t seed, const uint16_t threadsNo, BlockFill blockFill)
+        {
+            // blocks are laid over contiguous memory, columns of a block expression are generated aside
+            if(out.outerStride() != out.rows())
+            {
+                Matrix values(out.rows(), out.cols());
+                fillBlocks(values, seed, threadsNo, blockFill);
+                out = values;
+
+                return;
+            }
+
+            Scalar* values = out.data();
+            const size_t valuesNo = static_cast<size_t>(out.size());
+            const size_t blocksNo = (valuesNo + FILL_BLOCK_SIZE - 1U) / FILL_BLOCK_SIZE;
+
+            const size_t hardwareThreadsNo = std::max(1U, std::thread::hardware_concurrency());
+            const size_t maxThreadsNo = std::max<size_t>(1U, blocksNo / FILL_THREAD_MIN_BLOCKS);
+            const size_t usedThreadsNo = std::min<size_t>((NNFRAMEWORK_ZERO == threadsNo) ? hardwareThreadsNo : threadsNo, maxThreadsNo);
+
+            // contiguous range of blocks per thread, first range is generated by the calling thread
+            auto fillRange = [&](const size_t threadIdx)
+            {
+                const size_t firstBlock = (blocksNo * threadIdx) / usedThreadsNo;
+                const size_t lastBlock = (blocksNo * (threadIdx + 1U)) / usedThreadsNo;
+
+                for(size_t b = firstBlock; b < lastBlock; ++b)
+                {
+                    const size_t first = b * FILL_BLOCK_SIZE;
+                    blockFill(values + first, std::min(FILL_BLOCK_SIZE, valuesNo - first), mixSeed(seed, b));
+                }
+            };
+
+            std::vector<std::jthread> threads;
+            threads.reserve(usedThreadsNo - 1U);
+            for(size_t i = 1; i < usedThreadsNo; ++i)
+            {
+                threads.emplace_back(fillRange, i);
+            }
+            fillRange(0U);
+        }
+
+        void fillUniform(Eigen::Ref<Matrix> out, const Scalar low, const Scalar high, const uint64_t seed, const uint16_t threadsNo)
+        {
+            const Scalar range = high - low;
+
+            fillBlocks(out, seed, threadsNo, [low, range](Scalar* values, const size_t valuesNo, const uint64_t blockSeed)
+            {
+                LanesEngine engine(blockSeed);
+                uint64_t bits[FILL_LANES_NO];
+                Scalar lanes[FILL_LANES_NO];
+
+                for(size_t i = 0; i < valuesNo; i += FILL_LANES_NO)
+                {
+                    engine.next(bits);
+
+                    for(size_t l = 0; l < FILL_LANES_NO; ++l)
+                    {
+                        lanes[l] = low + (range * toUnit<Scalar>(bits[l]));
+                    }
+
+                    std::copy_n(lanes, std::min(FILL_LANES_NO, valuesNo - i), values + i);
+                }
+            });
+        }
+
+        void fillNormal(Eigen::Ref<Matrix> out, const Scalar mean, const Scalar stdDev, const uint64_t seed, const uint16_t threadsNo)
+        {
+            fillBlocks(out, seed, threadsNo, [mean, stdDev](Scalar* values, const size_t valuesNo, const uint64_t blockSeed)
+            {
+                // block sized arrays are held on the stack, no allocation per block
+                using BlockArray = Eigen::Array<Scalar, Eigen::Dynamic, 1, Eigen::ColMajor, FILL_BLOCK_SIZE / 2U, 1>;
+                constexpr Eigen::Index PAIRS_NO = static_cast<Eigen::Index>(FILL_LANES_NO / 2U);
+
+                // Box-Muller transform, each pair of uniform values (u1, u2) gives a pair of normal values
+                // first half of the block takes the cosine and the second half the sine of each pair
+                const Eigen::Index pairsNo = static_cast<Eigen::Index>((valuesNo + 1U) / 2U);
+
+                LanesEngine engine(blockSeed);
+                uint64_t bits[FILL_LANES_NO];
+                BlockArray u1(pairsNo);
+                BlockArray u2(pairsNo);
+
+                for(Eigen::Index i = 0; i < pairsNo; i += PAIRS_NO)
+                {
+                    engine.next(bits);
+
+                    const Eigen::Index lanesNo = std::min(PAIRS_NO, pairsNo - i);
+                    for(Eigen::Index l = 0; l < lanesNo; ++l)
+                    {
+                        u1(i + l) = static_cast<Scalar>(1.0) - toUnit<Scalar>(bits[l]);   // (0, 1], log(0) is avoided
+                        u2(i + l) = toUnit<Scalar>(bits[l + PAIRS_NO]);
+                    }
+                }
+
+                // transform is evaluated by Eigen array functions in the precision of Scalar
+                // normal values reach up to 5.7 (float) or 8.5 (double) standard deviations
+                const BlockArray r = (static_cast<Scalar>(-2.0) * u1.log()).sqrt();
+                const BlockArray theta = static_cast<Scalar>(2.0 * std::numbers::pi) * u2;
+
+                Eigen::Map<Eigen::Array<Scalar, Eigen::Dynamic, 1>> normalValues(values, static_cast<Eigen::Index>(valuesNo));
+                const Eigen::Index sinNo = static_cast<Eigen::Index>(valuesNo) - pairsNo;
+
+                normalValues.head(pairsNo) = mean + (stdDev * r * theta.cos());
+                normalValues.tail(sinNo) = mean + (stdDev * r.head(sinNo) * theta.head(sinNo).sin());
+            });
+        }
+    }
+}
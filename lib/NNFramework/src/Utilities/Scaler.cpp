@@ -0,0 +1,400 @@
+#include "Utilities/Scaler.hpp"
+#include "Utilities/ScalerFile.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+namespace NNFramework
+{
+    namespace Scaler
+    {
+        // Statistics of a part of the data
+        struct Stats final
+        {
+            uint64_t count = 0U;
+            Eigen::VectorXd mean;
+            Eigen::VectorXd m2;
+            Eigen::VectorXd min;
+            Eigen::VectorXd max;
+
+            explicit Stats(const Eigen::Index columnsNo) :
+                mean(Eigen::VectorXd::Zero(columnsNo)), m2(Eigen::VectorXd::Zero(columnsNo)),
+                min(Eigen::VectorXd::Constant(columnsNo, std::numeric_limits<double>::infinity())),
+                max(Eigen::VectorXd::Constant(columnsNo, -std::numeric_limits<double>::infinity()))
+            { }
+        };
+
+        // Merge statistics of two parts of the data (Chan et al. pairwise update of Welford statistics)
+        static void mergeInto(uint64_t& count, Eigen::VectorXd& mean, Eigen::VectorXd& m2, Eigen::VectorXd& min, Eigen::VectorXd& max,
+                              const uint64_t otherCount, const Eigen::VectorXd& otherMean, const Eigen::VectorXd& otherM2,
+                              const Eigen::VectorXd& otherMin, const Eigen::VectorXd& otherMax)
+        {
+            if(NNFRAMEWORK_ZERO == otherCount)
+            {
+                return;
+            }
+
+            const double totalCount = static_cast<double>(count) + static_cast<double>(otherCount);
+            const Eigen::ArrayXd delta = otherMean - mean;
+
+            mean.array() += delta * (static_cast<double>(otherCount) / totalCount);
+            m2.array() += otherM2.array() + (delta.square() * ((static_cast<double>(count) * static_cast<double>(otherCount)) / totalCount));
+            min = min.cwiseMin(otherMin);
+            max = max.cwiseMax(otherMax);
+            count += otherCount;
+        }
+
+        // Run job(firstRow, rowsNo) on ranges of data rows, first range is processed by the calling thread
+        template<class Job>
+        static void runRowRanges(const Eigen::Index rowsNo, const Eigen::Index columnsNo, const Eigen::Index minThreadValues, const uint16_t threadsNo, Job job)
+        {
+            const size_t hardwareThreadsNo = std::max(1U, std::thread::hardware_concurrency());
+            const size_t maxRangesNo = std::max<size_t>(1U, static_cast<size_t>((rowsNo * columnsNo) / minThreadValues));
+            const size_t rangesNo = std::min<size_t>((NNFRAMEWORK_ZERO == threadsNo) ? hardwareThreadsNo : threadsNo, maxRangesNo);
+
+            auto runRange = [&](const size_t rangeIdx)
+            {
+                const Eigen::Index firstRow = (rowsNo * static_cast<Eigen::Index>(rangeIdx)) / static_cast<Eigen::Index>(rangesNo);
+                const Eigen::Index lastRow = (rowsNo * static_cast<Eigen::Index>(rangeIdx + 1U)) / static_cast<Eigen::Index>(rangesNo);
+
+                job(rangeIdx, firstRow, lastRow - firstRow);
+            };
+
+            std::vector<std::jthread> threads;
+            threads.reserve(rangesNo - 1U);
+            for(size_t i = 1; i < rangesNo; ++i)
+            {
+                threads.emplace_back(runRange, i);
+            }
+            runRange(0U);
+        }
+
+        Scaler::Scaler(const ScalerType type) : mType(type), mCount(0U)
+        {
+            if((MIN_MAX != type) && (STANDARD != type))
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Unknown scaler type!");
+            }
+        }
+
+        // Drop collected statistics
+        void Scaler::reset()
+        {
+            mCount = 0U;
+            mMean.resize(0);
+            mM2.resize(0);
+            mMin.resize(0);
+            mMax.resize(0);
+            mOffset.resize(0);
+            mScale.resize(0);
+        }
+
+        // Collect statistics of the data, one data row per matrix row
+        void Scaler::partialFit(const Eigen::Ref<const Matrix>& data, const uint16_t threadsNo)
+        {
+            if((NNFRAMEWORK_ZERO != mCount) && (data.cols() != mMean.size()))
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Number of data columns does not match the scaler!");
+            }
+
+            if(NNFRAMEWORK_ZERO == data.rows())
+            {
+                return;
+            }
+
+            const Eigen::Index columnsNo = data.cols();
+            std::vector<Stats> rangeStats;
+
+            // the number of ranges is not known in advance, enough statistics for one range per hardware thread are prepared
+            const size_t maxRangesNo = std::max<size_t>({ 1U, threadsNo, std::thread::hardware_concurrency() });
+            rangeStats.reserve(maxRangesNo);
+            for(size_t i = 0; i < maxRangesNo; ++i)
+            {
+                rangeStats.emplace_back(columnsNo);
+            }
+
+            // each column of each block of rows is a contiguous segment, which stays in cache while its mean and
+            // deviations are computed, thus the data is read from memory only once
+            runRowRanges(data.rows(), columnsNo, MIN_THREAD_VALUES, threadsNo, [&](const size_t rangeIdx, const Eigen::Index firstRow, const Eigen::Index rowsNo)
+            {
+                Stats& stats = rangeStats[rangeIdx];
+                Stats block(columnsNo);
+
+                for(Eigen::Index blockRow = firstRow; blockRow < (firstRow + rowsNo); blockRow += FIT_BLOCK_ROWS)
+                {
+                    const Eigen::Index blockRowsNo = std::min(FIT_BLOCK_ROWS, (firstRow + rowsNo) - blockRow);
+
+                    for(Eigen::Index j = 0; j < columnsNo; ++j)
+                    {
+                        const auto segment = data.col(j).segment(blockRow, blockRowsNo).cast<double>().array();
+
+                        block.mean(j) = segment.sum() / static_cast<double>(blockRowsNo);
+                        block.m2(j) = (segment - block.mean(j)).square().sum();
+                        block.min(j) = segment.minCoeff();
+                        block.max(j) = segment.maxCoeff();
+                    }
+
+                    mergeInto(stats.count, stats.mean, stats.m2, stats.min, stats.max,
+                              static_cast<uint64_t>(blockRowsNo), block.mean, block.m2, block.min, block.max);
+                }
+            });
+
+            // ranges are merged in order, thus the result does not depend on the thread scheduling
+            for(const Stats& stats : rangeStats)
+            {
+                mergeStats(stats.count, stats.mean, stats.m2, stats.min, stats.max);
+            }
+        }
+
+        // Collect statistics of the data only, previously collected statistics are dropped
+        void Scaler::fit(const Eigen::Ref<const Matrix>& data, const uint16_t threadsNo)
+        {
+            reset();
+            partialFit(data, threadsNo);
+        }
+
+        // Take statistics of the named dataset columns saved in the dataset shards, no data is read
+        void Scaler::fit(const Dataset::Dataset& dataset, const std::vector<std::string>& columnNames)
+        {
+            const Eigen::Index columnsNo = static_cast<Eigen::Index>(columnNames.size());
+            Stats stats(columnsNo);
+
+            for(Eigen::Index j = 0; j < columnsNo; ++j)
+            {
+                const Dataset::ColumnStats& columnStats = dataset.get_mColumnStats(dataset.columnIdx(columnNames[j]));
+
+                // dataset holds population standard deviation
+                stats.mean(j) = columnStats.mean;
+                stats.m2(j) = columnStats.stdDev * columnStats.stdDev * static_cast<double>(dataset.get_mRowsNo());
+                stats.min(j) = columnStats.min;
+                stats.max(j) = columnStats.max;
+            }
+
+            reset();
+            mergeStats(dataset.get_mRowsNo(), stats.mean, stats.m2, stats.min, stats.max);
+        }
+
+        // Add statistics collected by the other scaler of the same columns
+        void Scaler::merge(const Scaler& other)
+        {
+            if((NNFRAMEWORK_ZERO != mCount) && (NNFRAMEWORK_ZERO != other.mCount) && (other.mMean.size() != mMean.size()))
+            {
+                std::cout << __FUNCTION__ << ": ";
+                throw std::runtime_error("Number of data columns does not match the scaler!");
+            }
+
+            mergeStats(other.mCount, other.mMean, other.mM2, other.mMin, other.mMax);
+        }
+
+        // Scale data in place, one data row per matrix row
+        void Scaler::transform(Eigen::Ref<Matrix> data, const uint16_t threadsNo) const
+        {
+            checkColumnsNo(__FUNCTION__, data.cols());
+
+            runRowRanges(data.rows(), data.cols(), MIN_THREAD_VALUES, threadsNo, [&](const size_t, const Eigen::Index firstRow, const Eigen::Index rowsNo)
+            {
+                for(Eigen::Index j = 0; j < data.cols(); ++j)
+                {
+                    auto segment = data.col(j).segment(firstRow, rowsNo).array();
+                    segment = (segment - mOffset(j)) * mScale(j);
+                }
+            });
+        }
+
+        // Undo the scaling of data in place
+        void Scaler::inverseTransform(Eigen::Ref<Matrix> data, const uint16_t threadsNo) const
+        {
+            checkColumnsNo(__FUNCTION__, data.cols());
+
+            runRowRanges(data.rows(), data.cols(), MIN_THREAD_VALUES, threadsNo, [&](const size_t, const Eigen::Index firstRow, const Eigen::Index rowsNo)
+            {
+                for(Eigen::Index j = 0; j < data.cols(); ++j)
+                {
+                    auto segment = data.col(j).segment(firstRow, rowsNo).array();
+                    segment = (segment / mScale(j)) + mOffset(j);
+                }
+            });
+        }
+
+        // Scale batch in place, one data row per batch column
+        void Scaler::transformBatch(Eigen::Ref<Matrix> batch) const
+        {
+            checkColumnsNo(__FUNCTION__, batch.rows());
+
+            batch.array().colwise() -= mOffset.array();
+            batch.array().colwise() *= mScale.array();
+        }
+
+        // Save collected statistics
+        bool Scaler::saveScaler(const std::string& path) const
+        {
+            try
+            {
+                checkColumnsNo(__FUNCTION__, mMean.size());
+
+                std::ofstream scalerFile(path, std::ios::out | std::ios::binary | std::ios::trunc);
+                if(false == scalerFile.is_open())
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Scaler file " + path + " cannot be created!");
+                }
+
+                ScalerFile::Header header {};
+                std::memcpy(header.magic, ScalerFile::MAGIC, sizeof(header.magic));
+                header.version = ScalerFile::VERSION;
+                header.type = mType;
+                header.columnsNo = get_mColumnsNo();
+                header.count = mCount;
+
+                scalerFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+                for(const Eigen::VectorXd* stats : { &mMean, &mM2, &mMin, &mMax })
+                {
+                    scalerFile.write(reinterpret_cast<const char*>(stats->data()), static_cast<std::streamsize>(stats->size() * sizeof(double)));
+                }
+
+                scalerFile.flush();
+                if(false == scalerFile.good())
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Scaler file " + path + " cannot be written!");
+                }
+
+                return true;
+            }
+            catch(const std::exception& e)
+            {
+                std::cerr << __FUNCTION__ << ": ";
+                std::cerr << e.what() << std::endl;
+                return false;
+            }
+        }
+
+        // Load statistics saved by saveScaler()
+        bool Scaler::loadScaler(const std::string& path)
+        {
+            try
+            {
+                std::ifstream scalerFile(path, std::ios::in | std::ios::binary);
+                if(false == scalerFile.is_open())
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Scaler file " + path + " cannot be opened!");
+                }
+
+                ScalerFile::Header header {};
+                scalerFile.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+                if((false == scalerFile.good()) || (0 != std::memcmp(header.magic, ScalerFile::MAGIC, sizeof(header.magic))) || (ScalerFile::VERSION != header.version))
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("File " + path + " is not a supported NNFramework scaler file!");
+                }
+
+                if(((MIN_MAX != header.type) && (STANDARD != header.type)) || (NNFRAMEWORK_ZERO == header.count) || (NNFRAMEWORK_ZERO == header.columnsNo))
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Scaler file " + path + " is corrupted!");
+                }
+
+                Stats stats(header.columnsNo);
+                for(Eigen::VectorXd* values : { &stats.mean, &stats.m2, &stats.min, &stats.max })
+                {
+                    scalerFile.read(reinterpret_cast<char*>(values->data()), static_cast<std::streamsize>(values->size() * sizeof(double)));
+                }
+
+                if(false == scalerFile.good())
+                {
+                    std::cout << __FUNCTION__ << ": ";
+                    throw std::runtime_error("Scaler file " + path + " is corrupted!");
+                }
+
+                // scaler is modified only after the whole file is read
+                mType = static_cast<ScalerType>(header.type);
+                reset();
+                mergeStats(header.count, stats.mean, stats.m2, stats.min, stats.max);
+
+                return true;
+            }
+            catch(const std::exception& e)
+            {
+                std::cerr << __FUNCTION__ << ": ";
+                std::cerr << e.what() << std::endl;
+                return false;
+            }
+        }
+
+        // Standard deviation of each column
+        Eigen::VectorXd Scaler::stdDev() const
+        {
+            if(NNFRAMEWORK_ZERO == mCount)
+            {
+                return Eigen::VectorXd();
+            }
+
+            return (mM2 / static_cast<double>(mCount)).cwiseSqrt();
+        }
+
+        // Merge statistics of data rows into the statistics of the scaler
+        void Scaler::mergeStats(const uint64_t count, const Eigen::VectorXd& mean, const Eigen::VectorXd& m2, const Eigen::VectorXd& min, const Eigen::VectorXd& max)
+        {
+            if(NNFRAMEWORK_ZERO == count)
+            {
+                return;
+            }
+
+            if(NNFRAMEWORK_ZERO == mCount)
+            {
+                const Stats empty(mean.size());
+                mMean = empty.mean;
+                mM2 = empty.m2;
+                mMin = empty.min;
+                mMax = empty.max;
+            }
+
+            mergeInto(mCount, mMean, mM2, mMin, mMax, count, mean, m2, min, max);
+
+            updateAffine();
+        }
+
+        // Compute mOffset and mScale from the statistics
+        void Scaler::updateAffine()
+        {
+            Eigen::VectorXd range;
+            if(MIN_MAX == mType)
+            {
+                mOffset = mMin.cast<Scalar>();
+                range = mMax - mMin;
+            }
+            else
+            {
+                mOffset = mMean.cast<Scalar>();
+                range = stdDev();
+            }
+
+            // constant columns are only shifted
+            mScale = range.unaryExpr([](double r) { return (0.0 < r) ? (1.0 / r) : 1.0; }).cast<Scalar>();
+        }
+
+        // Check if the scaler is fitted and matches the number of columns
+        void Scaler::checkColumnsNo(const std::string fName, const Eigen::Index columnsNo) const
+        {
+            if(NNFRAMEWORK_ZERO == mCount)
+            {
+                std::cout << fName << ": ";
+                throw std::runtime_error("Scaler is not fitted!");
+            }
+
+            if(columnsNo != mMean.size())
+            {
+                std::cout << fName << ": ";
+                throw std::runtime_error("Number of data columns does not match the scaler!");
+            }
+        }
+    }
+}
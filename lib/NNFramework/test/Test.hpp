@@ -0,0 +1,81 @@
+#ifndef TEST_HPP
+#define TEST_HPP
+
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <memory>
+#include "NNFramework/NNFramework"
+
+// Checks of the NNFramework test executables
+// every check is reported on std::cout, test executable fails (exit code 1) if any of the checks failed
+inline uint32_t gFailedChecksNo = 0U;
+
+inline void check(const bool condition, const std::string& description)
+{
+    std::cout << ((true == condition) ? "[PASS] " : "[FAIL] ") << description << std::endl;
+
+    if(false == condition)
+    {
+        ++gFailedChecksNo;
+    }
+}
+
+// Value in the description of a check, e.g. an error
+inline std::string toString(const double value)
+{
+    std::ostringstream s;
+    s << value;
+
+    return s.str();
+}
+
+// Exit code of the test executable
+inline int testResult()
+{
+    return (0U == gFailedChecksNo) ? 0 : 1;
+}
+
+// Training configuration of one test case
+struct FitCase final
+{
+    std::string description;
+    uint16_t threadsNo;
+    bool hogwild;
+    uint32_t prefetchDepth;
+    std::shared_ptr<NNFramework::Callbacks::CallbackFunctor> callback;    // nullptr -> no callback
+};
+
+// Compiled model trained as configured by the test case
+// layersSize -> number of perceptrons of each layer (input layer first), hidden layers use Tanh and the output layer Sigmoid
+inline std::shared_ptr<NNFramework::Model::Model> buildModel(const FitCase& fitCase, const std::vector<uint8_t>& layersSize, const uint32_t batchSize)
+{
+    using namespace NNFramework;
+
+    Model::ModelConfiguration::ModelConfiguration modelConfig { Loss::LossType<Loss::MeanSquaredError>(),
+                                                                Metrics::MetricsType<Metrics::MeanSquaredError>(),
+                                                                Optimizers::OptimizersType<Optimizers::GradientDescent>(),
+                                                                Model::ModelConfiguration::ShuffleData { true, 1 } };
+    modelConfig.mBatchSize = batchSize;
+    modelConfig.mThreadsNo = fitCase.threadsNo;
+    modelConfig.mHogwild = fitCase.hogwild;
+    modelConfig.mPrefetchDepth = fitCase.prefetchDepth;
+    if(nullptr != fitCase.callback)
+    {
+        modelConfig.mCallbacks.push_back(fitCase.callback);
+    }
+
+    std::shared_ptr<Model::Model> model = std::make_shared<Model::Model>();
+    model->addLayer(Layers::Dense(layersSize.front()));
+    for(size_t i = 1; i < (layersSize.size() - 1U); ++i)
+    {
+        model->addLayer(Layers::Dense(layersSize[i], Activations::ActivationType<Activations::Tanh>()));
+    }
+    model->addLayer(Layers::Dense(layersSize.back(), Activations::ActivationType<Activations::Sigmoid>()));
+    model->compileModel(modelConfig);
+
+    return model;
+}
+
+#endif
@@ -0,0 +1,175 @@
+#include <iostream>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <cerrno>
+#include "NNFramework/NNFramework"
+#include "Test.hpp"
+
+using namespace NNFramework;
+
+// Number of heap allocations of the whole process
+std::atomic<uint64_t> gAllocationsNo {0U};
+
+#ifdef __GLIBC__
+// Every allocation of the process is counted: Eigen allocates trough malloc(), operator new of libstdc++ calls malloc() as well
+// allocations are forwarded to the glibc allocator, thus free() does not have to be replaced
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+    void* __libc_memalign(size_t alignment, size_t size);
+
+    void* malloc(size_t size)
+    {
+        gAllocationsNo.fetch_add(1U, std::memory_order_relaxed);
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size)
+    {
+        gAllocationsNo.fetch_add(1U, std::memory_order_relaxed);
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* ptr, size_t size)
+    {
+        gAllocationsNo.fetch_add(1U, std::memory_order_relaxed);
+        return __libc_realloc(ptr, size);
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size)
+    {
+        gAllocationsNo.fetch_add(1U, std::memory_order_relaxed);
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** ptr, size_t alignment, size_t size)
+    {
+        gAllocationsNo.fetch_add(1U, std::memory_order_relaxed);
+        *ptr = __libc_memalign(alignment, size);
+        return (nullptr == *ptr) ? ENOMEM : 0;
+    }
+}
+#else
+// Only operator new is counted, allocations of Eigen trough malloc() are not seen on this platform
+void* operator new(size_t size)
+{
+    gAllocationsNo.fetch_add(1U, std::memory_order_relaxed);
+
+    void* ptr = std::malloc((0U == size) ? 1U : size);
+    if(nullptr == ptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t size) noexcept
+{
+    std::free(ptr);
+}
+#endif
+
+constexpr uint8_t INPUTS_NO = 8U;
+constexpr uint8_t OUTPUTS_NO = 2U;
+constexpr uint16_t EPOCHS_NO = 3U;
+constexpr uint32_t BATCH_SIZE = 16U;
+const std::vector<uint8_t> LAYERS_SIZE = { INPUTS_NO, 32U, 16U, OUTPUTS_NO };
+
+// Training observer recording the number of allocations from the first to the last optimizer step (or epoch)
+// steady state training has to reach the last step with the same number of allocations as the first one
+struct AllocationCounter final : Callbacks::CallbackFunctor
+{
+    bool onEpoch;
+    bool started = false;
+    uint64_t firstCount = 0U;
+    uint64_t lastCount = 0U;
+
+    explicit AllocationCounter(const bool onEpoch) : onEpoch(onEpoch) { }
+
+    std::string name() const override { return "AllocationCounter"; }
+
+    void onBatchEnd(const Callbacks::TrainingState&) override
+    {
+        if(false == onEpoch)
+        {
+            record();
+        }
+    }
+
+    void onEpochEnd(const Callbacks::TrainingState&) override
+    {
+        if(true == onEpoch)
+        {
+            record();
+        }
+    }
+
+    void record()
+    {
+        lastCount = gAllocationsNo.load(std::memory_order_relaxed);
+        if(false == started)
+        {
+            firstCount = lastCount;
+            started = true;
+        }
+    }
+};
+
+int main()
+{
+    const Matrix inData = Matrix::Random(1000, INPUTS_NO);
+    const Matrix expData = Matrix::Random(1000, OUTPUTS_NO).cwiseAbs();
+
+    // training, allocations of modelFit() before the first and after the last optimizer step (threads, history) are allowed
+    const std::vector<FitCase> fitCases = {
+        { "modelFit(), 1 thread", 1U, false, 0U, nullptr },
+        { "modelFit(), 2 threads", 2U, false, 0U, nullptr },
+        { "modelFit(), 2 Hogwild threads", 2U, true, 0U, nullptr },
+        { "modelFit(), 1 thread with prefetch", 1U, false, 4U, nullptr } };
+
+    for(const FitCase& fitCase : fitCases)
+    {
+        // Hogwild training does not call onBatchEnd(), steady state is measured from the first to the last epoch
+        std::shared_ptr<AllocationCounter> counter = std::make_shared<AllocationCounter>(fitCase.hogwild);
+        std::shared_ptr<Model::Model> model = buildModel({ fitCase.description, fitCase.threadsNo, fitCase.hogwild, fitCase.prefetchDepth, counter }, LAYERS_SIZE, BATCH_SIZE);
+
+        DataSource::MatrixDataSource dataSource(inData, expData);
+        model->modelFit(dataSource, EPOCHS_NO);
+
+        const uint64_t allocationsNo = counter->lastCount - counter->firstCount;
+        check((true == counter->started) && (0U == allocationsNo), fitCase.description + " does not allocate after the first step (" + std::to_string(allocationsNo) + " allocations)");
+    }
+
+    // prediction into the provided matrix, larger than one prediction tile
+    std::shared_ptr<Model::Model> model = buildModel(fitCases[0], LAYERS_SIZE, BATCH_SIZE);
+    Matrix predictedData(inData.rows(), OUTPUTS_NO);
+    Model::InferenceContext::InferenceContext context(model, 64U);
+
+    uint64_t startCount = gAllocationsNo.load(std::memory_order_relaxed);
+    model->modelPredict(inData, predictedData);
+    uint64_t allocationsNo = gAllocationsNo.load(std::memory_order_relaxed) - startCount;
+    check(0U == allocationsNo, "modelPredict(in, out) does not allocate (" + std::to_string(allocationsNo) + " allocations)");
+
+    startCount = gAllocationsNo.load(std::memory_order_relaxed);
+    context.predictInto(inData, predictedData);
+    allocationsNo = gAllocationsNo.load(std::memory_order_relaxed) - startCount;
+    check(0U == allocationsNo, "InferenceContext.predictInto() does not allocate (" + std::to_string(allocationsNo) + " allocations)");
+
+    // the counter has to see the allocations, otherwise the checks above pass for any code
+    startCount = gAllocationsNo.load(std::memory_order_relaxed);
+    const Matrix allocated = model->modelPredict(inData);
+    check(gAllocationsNo.load(std::memory_order_relaxed) > startCount, "allocations are counted");
+
+    return testResult();
+}
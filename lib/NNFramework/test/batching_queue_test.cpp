@@ -0,0 +1,301 @@
+#include <iostream>
+#include <string>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <stdexcept>
+#include "NNFramework/NNFramework"
+#include "Test.hpp"
+
+using namespace NNFramework;
+using namespace std::chrono_literals;
+
+// batched predictions differ from modelPredict() only by the rounding of the matrix products of different sizes
+#ifdef NNFRAMEWORK_USE_FLOAT32
+constexpr Scalar PREDICT_TOLERANCE = 1e-5;
+#else
+constexpr Scalar PREDICT_TOLERANCE = 1e-12;
+#endif
+
+constexpr uint8_t INPUTS_NO = 6U;
+constexpr uint8_t OUTPUTS_NO = 3U;
+
+// maxWait long enough to never expire during a test case, micro-batches are executed only when full or on destruction
+constexpr std::chrono::microseconds NEVER = 60s;
+
+// longest wait for a request which is expected to complete
+constexpr std::chrono::seconds COMPLETE_TIMEOUT = 10s;
+
+const std::string ACTIVATION_ERROR = "activation error";
+const std::string CALLBACK_ERROR = "callback error";
+
+// Output activation failing the forward pass of every micro-batch
+struct FailingActivation final : Activations::ActivationFunctor
+{
+    std::string name() const override { return "FailingActivation"; }
+
+    void activate(const Eigen::Ref<const Matrix>&, Eigen::Ref<Matrix>) const override
+    {
+        throw std::runtime_error(ACTIVATION_ERROR);
+    }
+
+    void derivative(const Eigen::Ref<const Matrix>&, Eigen::Ref<Matrix>) const override
+    {
+        throw std::runtime_error(ACTIVATION_ERROR);
+    }
+};
+
+// Result of a request submitted with a callback
+struct CallbackResult final
+{
+    std::promise<Vector> outputRow;
+    std::promise<std::string> error;
+    std::atomic<uint32_t> callsNo {0U};
+};
+
+// Callback recording the output row or the error of the request
+Model::BatchingQueue::BatchingQueue::Callback recordingCallback(CallbackResult& result)
+{
+    return [&result](const Eigen::Ref<const Vector>& outputRow, const std::exception_ptr& error)
+    {
+        ++result.callsNo;
+
+        if(nullptr == error)
+        {
+            result.outputRow.set_value(outputRow);
+            result.error.set_value("");
+            return;
+        }
+
+        try
+        {
+            std::rethrow_exception(error);
+        }
+        catch(const std::exception& e)
+        {
+            result.outputRow.set_value(Vector());
+            result.error.set_value(e.what());
+        }
+    };
+}
+
+// Compiled model shared by the queue
+std::shared_ptr<Model::Model> buildServingModel(std::unique_ptr<Activations::ActivationFunctor> outputActivation)
+{
+    Model::ModelConfiguration::ModelConfiguration modelConfig { Loss::LossType<Loss::MeanSquaredError>(),
+                                                                Metrics::MetricsType<Metrics::MeanSquaredError>(),
+                                                                Optimizers::OptimizersType<Optimizers::GradientDescent>(),
+                                                                Model::ModelConfiguration::ShuffleData { false, 1 } };
+
+    std::shared_ptr<Model::Model> model = std::make_shared<Model::Model>();
+    model->addLayer(Layers::Dense(INPUTS_NO));
+    model->addLayer(Layers::Dense(10, Activations::ActivationType<Activations::Tanh>()));
+    model->addLayer(Layers::Dense(OUTPUTS_NO, std::move(outputActivation)));
+    model->compileModel(modelConfig);
+
+    return model;
+}
+
+// Statistics of the queue once requestsNo requests are counted
+// requests are counted after they are completed, thus completed futures do not guarantee up to date statistics
+Model::BatchingQueue::BatchingStats waitForStats(const Model::BatchingQueue::BatchingQueue& queue, const uint64_t requestsNo)
+{
+    const auto deadline = std::chrono::steady_clock::now() + COMPLETE_TIMEOUT;
+
+    Model::BatchingQueue::BatchingStats stats = queue.get_mStats();
+    while((stats.requestsNo < requestsNo) && (std::chrono::steady_clock::now() < deadline))
+    {
+        std::this_thread::sleep_for(1ms);
+        stats = queue.get_mStats();
+    }
+
+    return stats;
+}
+
+// Check that the future is completed in time
+template<class T>
+bool isCompleted(std::future<T>& result)
+{
+    return std::future_status::ready == result.wait_for(COMPLETE_TIMEOUT);
+}
+
+int main()
+{
+    const Matrix inData = Matrix::Random(200, INPUTS_NO);
+    std::shared_ptr<Model::Model> model = buildServingModel(std::make_unique<Activations::Sigmoid>());
+    const Matrix expected = model->modelPredict(inData);
+
+    // requests submitted concurrently by many threads are predicted as by modelPredict()
+    {
+        Model::BatchingQueue::BatchingQueue queue(model, 16U, 200us);
+
+        constexpr uint32_t SUBMITTERS_NO = 4U;
+        std::vector<std::future<Vector>> results(inData.rows());
+        std::vector<std::thread> submitters;
+        for(uint32_t t = 0; t < SUBMITTERS_NO; ++t)
+        {
+            submitters.emplace_back([&, t]()
+            {
+                for(Eigen::Index row = t; row < inData.rows(); row += SUBMITTERS_NO)
+                {
+                    results[row] = queue.submit(inData.row(row).transpose());
+                }
+            });
+        }
+        for(std::thread& submitter : submitters)
+        {
+            submitter.join();
+        }
+
+        Scalar maxError = 0.0;
+        bool completed = true;
+        for(Eigen::Index row = 0; row < inData.rows(); ++row)
+        {
+            completed = completed && isCompleted(results[row]);
+            if(true == completed)
+            {
+                maxError = std::max(maxError, (results[row].get() - expected.row(row).transpose()).cwiseAbs().maxCoeff());
+            }
+        }
+        check(true == completed, "all concurrent requests are completed");
+        check(maxError < PREDICT_TOLERANCE, "batched predictions match modelPredict() row by row (max error " + toString(maxError) + ")");
+
+        const Model::BatchingQueue::BatchingStats stats = waitForStats(queue, inData.rows());
+        check((static_cast<uint64_t>(inData.rows()) == stats.requestsNo) && (0U == stats.failedNo), "all concurrent requests are counted as completed");
+        check(stats.maxBatchSize <= 16U, "micro-batches are capped by maxBatchSize (largest " + std::to_string(stats.maxBatchSize) + ")");
+    }
+
+    // full micro-batches are executed without waiting for maxWait
+    {
+        Model::BatchingQueue::BatchingQueue queue(model, 4U, NEVER);
+
+        std::vector<std::future<Vector>> results;
+        for(Eigen::Index row = 0; row < 8; ++row)
+        {
+            results.push_back(queue.submit(inData.row(row).transpose()));
+        }
+
+        bool completed = true;
+        for(std::future<Vector>& result : results)
+        {
+            completed = completed && isCompleted(result);
+        }
+        check(true == completed, "full micro-batches are executed before maxWait");
+
+        const Model::BatchingQueue::BatchingStats stats = waitForStats(queue, 8U);
+        check((2U == stats.batchesNo) && (4U == stats.maxBatchSize), "8 requests are executed as 2 micro-batches of maxBatchSize 4");
+    }
+
+    // single request is flushed once it waited for maxWait
+    {
+        constexpr std::chrono::milliseconds MAX_WAIT = 50ms;
+        Model::BatchingQueue::BatchingQueue queue(model, 32U, MAX_WAIT);
+
+        const auto submitTime = std::chrono::steady_clock::now();
+        std::future<Vector> result = queue.submit(inData.row(0).transpose());
+        const bool completed = isCompleted(result);
+        const auto waitTime = std::chrono::steady_clock::now() - submitTime;
+
+        check(true == completed, "single request is flushed after maxWait");
+        check(waitTime >= MAX_WAIT, "single request waits for maxWait (" + toString(std::chrono::duration<double, std::milli>(waitTime).count()) + " ms)");
+        check(1U == waitForStats(queue, 1U).maxBatchSize, "single request is executed as a micro-batch of 1");
+    }
+
+    // exception of a callback does not affect the other requests of the micro-batch
+    {
+        // callback results outlive the queue, thus the batching thread is stopped before they are destroyed
+        CallbackResult lastResult;
+        std::atomic<uint32_t> failingCallsNo {0U};
+        Model::BatchingQueue::BatchingQueue queue(model, 4U, NEVER);
+
+        std::future<Vector> firstResult = queue.submit(inData.row(0).transpose());
+        queue.submit(inData.row(1).transpose(), [&failingCallsNo](const Eigen::Ref<const Vector>&, const std::exception_ptr&)
+        {
+            ++failingCallsNo;
+            throw std::runtime_error(CALLBACK_ERROR);
+        });
+        std::future<Vector> thirdResult = queue.submit(inData.row(2).transpose());
+        queue.submit(inData.row(3).transpose(), recordingCallback(lastResult));
+
+        std::future<Vector> lastOutputRow = lastResult.outputRow.get_future();
+        check((true == isCompleted(firstResult)) && (true == isCompleted(thirdResult)) && (true == isCompleted(lastOutputRow)),
+              "requests next to a failing callback are completed");
+
+        Scalar maxError = (firstResult.get() - expected.row(0).transpose()).cwiseAbs().maxCoeff();
+        maxError = std::max(maxError, (thirdResult.get() - expected.row(2).transpose()).cwiseAbs().maxCoeff());
+        maxError = std::max(maxError, (lastOutputRow.get() - expected.row(3).transpose()).cwiseAbs().maxCoeff());
+        check(maxError < PREDICT_TOLERANCE, "requests next to a failing callback get their own predictions");
+        check((1U == failingCallsNo) && (1U == lastResult.callsNo), "every callback is called once");
+
+        const Model::BatchingQueue::BatchingStats stats = waitForStats(queue, 4U);
+        check((4U == stats.requestsNo) && (1U == stats.failedNo), "failing callback is counted in failedNo");
+    }
+
+    // failed prediction reaches every caller of the micro-batch
+    {
+        std::shared_ptr<const Model::Model> failingModel = buildServingModel(std::make_unique<FailingActivation>());
+        CallbackResult secondResult;
+        CallbackResult lastResult;
+        Model::BatchingQueue::BatchingQueue queue(failingModel, 4U, NEVER);
+
+        std::future<Vector> firstResult = queue.submit(inData.row(0).transpose());
+        queue.submit(inData.row(1).transpose(), recordingCallback(secondResult));
+        std::future<Vector> thirdResult = queue.submit(inData.row(2).transpose());
+        queue.submit(inData.row(3).transpose(), recordingCallback(lastResult));
+
+        for(std::future<Vector>* result : { &firstResult, &thirdResult })
+        {
+            std::string error;
+            try
+            {
+                if(true == isCompleted(*result))
+                {
+                    result->get();
+                }
+            }
+            catch(const std::exception& e)
+            {
+                error = e.what();
+            }
+            check(ACTIVATION_ERROR == error, "failed prediction is passed to the future");
+        }
+
+        for(CallbackResult* result : { &secondResult, &lastResult })
+        {
+            std::future<std::string> error = result->error.get_future();
+            check((true == isCompleted(error)) && (ACTIVATION_ERROR == error.get()) && (1U == result->callsNo), "failed prediction is passed to the callback");
+        }
+
+        const Model::BatchingQueue::BatchingStats stats = waitForStats(queue, 4U);
+        check((4U == stats.requestsNo) && (4U == stats.failedNo), "failed requests are counted in failedNo");
+    }
+
+    // destructor completes the waiting requests without waiting for maxWait
+    {
+        CallbackResult callbackResult;
+        std::unique_ptr<Model::BatchingQueue::BatchingQueue> queue = std::make_unique<Model::BatchingQueue::BatchingQueue>(model, 32U, NEVER);
+        std::vector<std::future<Vector>> results;
+        for(Eigen::Index row = 0; row < 3; ++row)
+        {
+            results.push_back(queue->submit(inData.row(row).transpose()));
+        }
+        queue->submit(inData.row(3).transpose(), recordingCallback(callbackResult));
+
+        const auto stopTime = std::chrono::steady_clock::now();
+        queue.reset();
+        const auto drainTime = std::chrono::steady_clock::now() - stopTime;
+
+        bool completed = (1U == callbackResult.callsNo);
+        for(std::future<Vector>& result : results)
+        {
+            completed = completed && (std::future_status::ready == result.wait_for(0s));
+        }
+        check(true == completed, "destructor completes all waiting requests");
+        check(drainTime < COMPLETE_TIMEOUT, "destructor does not wait for maxWait");
+    }
+
+    return testResult();
+}
@@ -0,0 +1,132 @@
+#include <iostream>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <cstdio>
+#include "NNFramework/NNFramework"
+#include "Test.hpp"
+
+using namespace NNFramework;
+
+constexpr uint8_t INPUTS_NO = 4U;
+constexpr uint8_t OUTPUTS_NO = 2U;
+constexpr uint16_t EPOCHS_NO = 3U;
+
+// number of parameters in one incremental block, the model has several blocks per layer
+constexpr uint32_t BLOCK_SIZE = 8U;
+
+// Add layers to the model and compile it, callback == nullptr -> no callback
+void compile(Model::Model& model, std::shared_ptr<Callbacks::CallbackFunctor> callback)
+{
+    Model::ModelConfiguration::ModelConfiguration modelConfig { Loss::LossType<Loss::MeanSquaredError>(),
+                                                                Metrics::MetricsType<Metrics::MeanSquaredError>(),
+                                                                Optimizers::OptimizersType<Optimizers::GradientDescent>(),
+                                                                Model::ModelConfiguration::ShuffleData { true, 1 } };
+    modelConfig.mBatchSize = 8U;
+    if(nullptr != callback)
+    {
+        modelConfig.mCallbacks.push_back(callback);
+    }
+
+    model.addLayer(Layers::Dense(INPUTS_NO));
+    model.addLayer(Layers::Dense(6, Activations::ActivationType<Activations::Tanh>()));
+    model.addLayer(Layers::Dense(OUTPUTS_NO, Activations::ActivationType<Activations::Sigmoid>()));
+    model.compileModel(modelConfig);
+}
+
+// Check that the checkpoint file holds the given parameters
+bool checkpointEquals(const std::string& checkpointPath, const Eigen::Ref<const Vector>& parameters)
+{
+    Model::Model checkpoint;
+
+    return (true == checkpoint.loadModel(checkpointPath)) && (checkpoint.get_mParameters() == parameters);
+}
+
+// Number of blocks of parameters which differ between before and after
+uint64_t changedBlocksNo(const Vector& before, const Vector& after)
+{
+    uint64_t blocksNo = 0U;
+    for(Eigen::Index blockIdx = 0; blockIdx < before.size(); blockIdx += BLOCK_SIZE)
+    {
+        const Eigen::Index blockRows = std::min<Eigen::Index>(BLOCK_SIZE, before.size() - blockIdx);
+        if(before.segment(blockIdx, blockRows) != after.segment(blockIdx, blockRows))
+        {
+            ++blocksNo;
+        }
+    }
+
+    return blocksNo;
+}
+
+int main()
+{
+    const std::string checkpointPath = "./checkpointer_test.nnfw";
+    const std::string unwritablePath = "./checkpointer_test_missing_directory/checkpoint.nnfw";
+
+    const Matrix inData = Matrix::Random(100, INPUTS_NO);
+    const Matrix expData = Matrix::Random(100, OUTPUTS_NO).cwiseAbs();
+
+    // checkpoint after each epoch and a final one, snapshots taken while the previous one is written may be replaced
+    for(const bool incremental : { false, true })
+    {
+        const std::string mode = (true == incremental) ? "incremental" : "full";
+
+        Model::Model model;
+        std::shared_ptr<Model::Checkpointer::Checkpointer> checkpointer =
+            std::make_shared<Model::Checkpointer::Checkpointer>(model, checkpointPath, 1U, std::chrono::seconds(0), incremental, BLOCK_SIZE);
+        compile(model, checkpointer);
+
+        model.modelFit(inData, expData, EPOCHS_NO);
+
+        check(true == checkpointEquals(checkpointPath, model.get_mParameters()), mode + " checkpoint reloaded after modelFit() equals the model parameters");
+        check((0U == checkpointer->get_mFailedNo()) && (true == checkpointer->get_mLastError().empty()), mode + " checkpoints do not fail");
+        check((EPOCHS_NO + 1U) == (checkpointer->get_mWrittenNo() + checkpointer->get_mReplacedNo()),
+              mode + " checkpoints are written or replaced after each epoch and at the end (" + std::to_string(checkpointer->get_mWrittenNo()) + " written)");
+
+        std::remove(checkpointPath.c_str());
+    }
+
+    // incremental checkpoint rewrites only the changed blocks
+    {
+        Model::Model model;
+        Model::Checkpointer::Checkpointer checkpointer(model, checkpointPath, 1U, std::chrono::seconds(0), true, BLOCK_SIZE);
+        compile(model, nullptr);
+
+        const Callbacks::TrainingState state {};
+
+        // first checkpoint is written as a whole, unchanged parameters rewrite no blocks
+        checkpointer.onTrainEnd(state);
+        checkpointer.onTrainEnd(state);
+        check((2U == checkpointer.get_mWrittenNo()) && (0U == checkpointer.get_mWrittenBlocksNo()), "unchanged parameters rewrite no blocks");
+
+        // one weight of the hidden layer and one bias of the output layer are changed, they lie in different blocks
+        const Vector before = model.get_mParameters();
+        model.get_mLayers()[1]->get_mLayerWeights()(0, 0) += static_cast<Scalar>(1.0);
+        model.get_mLayers()[2]->get_mLayerBias()(0, 0) += static_cast<Scalar>(1.0);
+        const uint64_t expectedBlocksNo = changedBlocksNo(before, model.get_mParameters());
+
+        checkpointer.onTrainEnd(state);
+        check(2U == expectedBlocksNo, "changed parameters lie in 2 blocks");
+        check(expectedBlocksNo == checkpointer.get_mWrittenBlocksNo(), "only the changed blocks are rewritten (" + std::to_string(checkpointer.get_mWrittenBlocksNo()) + " blocks)");
+        check(true == checkpointEquals(checkpointPath, model.get_mParameters()), "incremental checkpoint equals the changed parameters");
+
+        std::remove(checkpointPath.c_str());
+    }
+
+    // checkpoint which cannot be written is counted and reported, training continues
+    {
+        Model::Model model;
+        std::shared_ptr<Model::Checkpointer::Checkpointer> checkpointer = std::make_shared<Model::Checkpointer::Checkpointer>(model, unwritablePath);
+        compile(model, checkpointer);
+
+        model.modelFit(inData, expData, EPOCHS_NO);
+
+        check(EPOCHS_NO == model.get_mModelHistory().hLoss.size(), "training continues after failed checkpoints");
+        check((0U == checkpointer->get_mWrittenNo()) && (checkpointer->get_mFailedNo() > 0U),
+              "failed checkpoints are counted (" + std::to_string(checkpointer->get_mFailedNo()) + " failed)");
+        check((EPOCHS_NO + 1U) == (checkpointer->get_mFailedNo() + checkpointer->get_mReplacedNo()), "every checkpoint either failed or was replaced");
+        check(false == checkpointer->get_mLastError().empty(), "error of the last failed checkpoint is kept (" + checkpointer->get_mLastError() + ")");
+    }
+
+    return testResult();
+}
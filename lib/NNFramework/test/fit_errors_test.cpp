@@ -0,0 +1,150 @@
+#include <iostream>
+#include <string>
+#include <memory>
+#include <stdexcept>
+#include "NNFramework/NNFramework"
+#include "Test.hpp"
+
+using namespace NNFramework;
+
+constexpr uint8_t INPUTS_NO = 3U;
+constexpr uint8_t OUTPUTS_NO = 1U;
+constexpr uint16_t EPOCHS_NO = 3U;
+
+const std::string SOURCE_ERROR = "data source error";
+const std::string CALLBACK_ERROR = "callback error";
+
+// Data source throwing from the failingCall-th call of nextBatch() or reset()
+class FailingDataSource final : public DataSource::DataSource
+{
+    public:
+        enum FailingMethod : uint8_t
+        {
+            NEXT_BATCH = 0U,
+            RESET = 1U
+        };
+
+        FailingDataSource(const Matrix& inData, const Matrix& expData, const FailingMethod method, const uint32_t failingCall) :
+            mSource(inData, expData), mMethod(method), mFailingCall(failingCall), mCallsNo(0U) { }
+
+        std::string name() const override { return "FailingDataSource"; }
+
+        uint32_t inputColsNo() const override { return mSource.inputColsNo(); }
+        uint32_t expectedColsNo() const override { return mSource.expectedColsNo(); }
+        uint64_t rowsNo() const override { return mSource.rowsNo(); }
+
+        void reset(const bool shuffle) override
+        {
+            failOnCall(RESET);
+            mSource.reset(shuffle);
+        }
+
+        uint32_t nextBatch(Eigen::Ref<Matrix> inBatch, Eigen::Ref<Matrix> expBatch) override
+        {
+            failOnCall(NEXT_BATCH);
+            return mSource.nextBatch(inBatch, expBatch);
+        }
+
+    private:
+        ::NNFramework::DataSource::MatrixDataSource mSource;
+        FailingMethod mMethod;
+        uint32_t mFailingCall;
+        uint32_t mCallsNo;
+
+        void failOnCall(const FailingMethod method)
+        {
+            if((mMethod == method) && (++mCallsNo == mFailingCall))
+            {
+                throw std::runtime_error(SOURCE_ERROR);
+            }
+        }
+};
+
+// Training observer throwing from the failingCall-th call of onBatchEnd() or onEpochEnd()
+struct FailingCallback final : Callbacks::CallbackFunctor
+{
+    bool onEpoch;
+    uint32_t failingCall;
+    uint32_t callsNo = 0U;
+
+    FailingCallback(const bool onEpoch, const uint32_t failingCall) : onEpoch(onEpoch), failingCall(failingCall) { }
+
+    std::string name() const override { return "FailingCallback"; }
+
+    void onBatchEnd(const Callbacks::TrainingState&) override
+    {
+        if((false == onEpoch) && (++callsNo == failingCall))
+        {
+            throw std::runtime_error(CALLBACK_ERROR);
+        }
+    }
+
+    void onEpochEnd(const Callbacks::TrainingState&) override
+    {
+        if((true == onEpoch) && (++callsNo == failingCall))
+        {
+            throw std::runtime_error(CALLBACK_ERROR);
+        }
+    }
+};
+
+// Train the model on the data source and check that the exception thrown during training reaches the caller
+void checkFit(const FitCase& fitCase, DataSource::DataSource& dataSource, const std::string& expectedError)
+{
+    std::shared_ptr<Model::Model> model = buildModel(fitCase, { INPUTS_NO, 4U, OUTPUTS_NO }, 8U);
+
+    std::string error;
+    try
+    {
+        model->modelFit(dataSource, EPOCHS_NO);
+    }
+    catch(const std::exception& e)
+    {
+        error = e.what();
+    }
+
+    check(expectedError == error, fitCase.description + " -> exception is rethrown by modelFit()");
+}
+
+int main()
+{
+    const Matrix inData = Matrix::Random(100, INPUTS_NO);
+    const Matrix expData = Matrix::Random(100, OUTPUTS_NO).cwiseAbs();
+
+    // data source failing in the middle of the first epoch, in the second epoch and at the start of the second epoch
+    const std::vector<FitCase> sourceCases = {
+        { "1 thread, nextBatch() throws", 1U, false, 0U, nullptr },
+        { "2 threads, nextBatch() throws", 2U, false, 0U, nullptr },
+        { "3 threads, nextBatch() throws", 3U, false, 0U, nullptr },
+        { "2 threads with prefetch, nextBatch() throws", 2U, false, 2U, nullptr },
+        { "2 Hogwild threads, nextBatch() throws", 2U, true, 0U, nullptr },
+        { "3 Hogwild threads, nextBatch() throws", 3U, true, 0U, nullptr } };
+
+    for(const FitCase& fitCase : sourceCases)
+    {
+        for(const uint32_t failingCall : { 3U, 17U })
+        {
+            FailingDataSource dataSource(inData, expData, FailingDataSource::NEXT_BATCH, failingCall);
+            checkFit({ fitCase.description + " (call " + std::to_string(failingCall) + ")", fitCase.threadsNo, fitCase.hogwild, fitCase.prefetchDepth, nullptr },
+                     dataSource, SOURCE_ERROR);
+        }
+
+        FailingDataSource dataSource(inData, expData, FailingDataSource::RESET, 2U);
+        checkFit({ fitCase.description.substr(0, fitCase.description.find(',')) + ", reset() throws", fitCase.threadsNo, fitCase.hogwild, fitCase.prefetchDepth, nullptr },
+                 dataSource, SOURCE_ERROR);
+    }
+
+    // training observer failing after an optimizer step and after an epoch
+    const std::vector<FitCase> callbackCases = {
+        { "2 threads, onBatchEnd() throws", 2U, false, 0U, std::make_shared<FailingCallback>(false, 5U) },
+        { "2 threads, onEpochEnd() throws", 2U, false, 0U, std::make_shared<FailingCallback>(true, 1U) },
+        { "2 Hogwild threads, onEpochEnd() throws", 2U, true, 0U, std::make_shared<FailingCallback>(true, 2U) } };
+
+    for(const FitCase& fitCase : callbackCases)
+    {
+        DataSource::MatrixDataSource dataSource(inData, expData);
+        checkFit(fitCase, dataSource, CALLBACK_ERROR);
+    }
+
+    return testResult();
+}
@@ -0,0 +1,90 @@
+#include <iostream>
+#include <string>
+#include <cstdio>
+#include "NNFramework/NNFramework"
+#include "Test.hpp"
+
+using namespace NNFramework;
+
+// predictions of the folded model differ from the original model only by the rounding of the folded coefficients
+#ifdef NNFRAMEWORK_USE_FLOAT32
+constexpr Scalar FOLD_TOLERANCE = 1e-5;
+#else
+constexpr Scalar FOLD_TOLERANCE = 1e-12;
+#endif
+
+constexpr uint8_t INPUTS_NO = 5U;
+constexpr uint8_t OUTPUTS_NO = 2U;
+
+// Model configuration used by all models of the test
+Model::ModelConfiguration::ModelConfiguration makeConfig()
+{
+    return Model::ModelConfiguration::ModelConfiguration { Loss::LossType<Loss::MeanSquaredError>(),
+                                                           Metrics::MetricsType<Metrics::MeanSquaredError>(),
+                                                           Optimizers::OptimizersType<Optimizers::GradientDescent>(),
+                                                           Model::ModelConfiguration::ShuffleData { false, 1 } };
+}
+
+// Compile model, layers are created by loadModel() if modelPath is not empty
+void compile(Model::Model& model, const std::string& modelPath = "")
+{
+    if(true == modelPath.empty())
+    {
+        model.addLayer(Layers::Dense(INPUTS_NO));
+        model.addLayer(Layers::Dense(8, Activations::ActivationType<Activations::Tanh>()));
+        model.addLayer(Layers::Dense(OUTPUTS_NO, Activations::ActivationType<Activations::Sigmoid>()));
+    }
+    else
+    {
+        model.loadModel(modelPath);
+    }
+
+    Model::ModelConfiguration::ModelConfiguration modelConfig = makeConfig();
+    model.compileModel(modelConfig);
+}
+
+int main()
+{
+    const std::string modelPath = "./fold_test_model.nnfw";
+    const std::string foldedPath = "./fold_test_folded.nnfw";
+
+    // raw inputs far from the scaled range, each column with its own offset and spread
+    Matrix rawData = Matrix::Random(256, INPUTS_NO);
+    for(Eigen::Index col = 0; col < rawData.cols(); ++col)
+    {
+        rawData.col(col) = (rawData.col(col).array() * static_cast<Scalar>(10.0 * (col + 1))) + static_cast<Scalar>(100.0 * col);
+    }
+
+    Scaler::Scaler inScaler(Scaler::Scaler::STANDARD);
+    inScaler.fit(rawData);
+
+    Matrix scaledData = rawData;
+    inScaler.transform(scaledData);
+
+    // original model predicts on the scaled inputs
+    Model::Model model;
+    compile(model);
+    const Matrix expected = model.modelPredict(scaledData);
+
+    // folded compiled model predicts on the raw inputs
+    check(true == model.saveModel(modelPath), "original model is saved");
+    model.foldInputScaler(inScaler);
+    const Scalar compiledError = (model.modelPredict(rawData) - expected).cwiseAbs().maxCoeff();
+    check(compiledError < FOLD_TOLERANCE, "folded compiled model matches the original model (max error " + toString(compiledError) + ")");
+
+    // model loaded but not compiled is folded and saved for serving
+    Model::Model loadedModel;
+    check(true == loadedModel.loadModel(modelPath), "original model is loaded");
+    loadedModel.foldInputScaler(inScaler);
+    check(true == loadedModel.saveModel(foldedPath), "folded loaded model is saved");
+
+    Model::Model servingModel;
+    compile(servingModel, foldedPath);
+    const Scalar loadedError = (servingModel.modelPredict(rawData) - expected).cwiseAbs().maxCoeff();
+    check(loadedError < FOLD_TOLERANCE, "folded loaded model matches the original model (max error " + toString(loadedError) + ")");
+
+    std::remove(modelPath.c_str());
+    std::remove(foldedPath.c_str());
+
+    return testResult();
+}
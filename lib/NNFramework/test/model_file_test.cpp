@@ -0,0 +1,90 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdio>
+#include <limits>
+#include "NNFramework/NNFramework"
+#include "NNFramework/inc/Core/ModelFile.hpp"
+#include "Test.hpp"
+
+using namespace NNFramework;
+
+constexpr uint8_t INPUTS_NO = 4U;
+constexpr uint8_t OUTPUTS_NO = 2U;
+
+// Write the header followed by the zeroed rest of the model file
+void writeModelFile(const std::string& path, const Model::ModelFile::Header& header, const size_t restSize)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    const std::vector<char> rest(restSize, 0);
+    file.write(rest.data(), static_cast<std::streamsize>(rest.size()));
+}
+
+// Header of a valid model file with the given number of layers
+Model::ModelFile::Header makeHeader(const uint32_t layersNo, const uint64_t parametersNo)
+{
+    Model::ModelFile::Header header {};
+    std::copy(std::begin(Model::ModelFile::MAGIC), std::end(Model::ModelFile::MAGIC), header.magic);
+    header.version = Model::ModelFile::VERSION;
+    header.scalarSize = sizeof(Scalar);
+    header.layersNo = layersNo;
+    header.parametersNo = parametersNo;
+    header.parametersOffset = Model::ModelFile::parametersOffset(layersNo);
+
+    return header;
+}
+
+int main()
+{
+    const std::string modelPath = "./model_file_test_model.nnfw";
+    const std::string corruptedPath = "./model_file_test_corrupted.nnfw";
+
+    Model::ModelConfiguration::ModelConfiguration modelConfig { Loss::LossType<Loss::MeanSquaredError>(),
+                                                                Metrics::MetricsType<Metrics::MeanSquaredError>(),
+                                                                Optimizers::OptimizersType<Optimizers::GradientDescent>(),
+                                                                Model::ModelConfiguration::ShuffleData { false, 1 } };
+
+    // saved model is loaded into an empty model with the same parameters and predictions
+    Model::Model model;
+    model.addLayer(Layers::Dense(INPUTS_NO));
+    model.addLayer(Layers::Dense(6, Activations::ActivationType<Activations::Tanh>()));
+    model.addLayer(Layers::Dense(OUTPUTS_NO, Activations::ActivationType<Activations::Sigmoid>()));
+    model.compileModel(modelConfig);
+    check(true == model.saveModel(modelPath), "model is saved");
+
+    Model::Model loadedModel;
+    check(true == loadedModel.loadModel(modelPath), "saved model is loaded");
+    loadedModel.compileModel(modelConfig);
+    check(model.get_mParameters() == loadedModel.get_mParameters(), "loaded parameters equal the saved parameters");
+
+    const Matrix inData = Matrix::Random(32, INPUTS_NO);
+    check(model.modelPredict(inData) == loadedModel.modelPredict(inData), "loaded model predicts the same as the saved model");
+
+    // well-formed headers with invalid contents are rejected, the model stays empty
+    struct CorruptedCase final
+    {
+        std::string description;
+        Model::ModelFile::Header header;
+    };
+
+    const std::vector<CorruptedCase> corruptedCases = {
+        { "model file without layers", makeHeader(0U, 0U) },
+        { "model file with only the input layer", makeHeader(1U, 0U) },
+        { "model file with overflowing parameters size", makeHeader(2U, std::numeric_limits<uint64_t>::max() / 2U + 1U) } };
+
+    for(const CorruptedCase& corruptedCase : corruptedCases)
+    {
+        writeModelFile(corruptedPath, corruptedCase.header, static_cast<size_t>(corruptedCase.header.parametersOffset - sizeof(corruptedCase.header)));
+
+        Model::Model corruptedModel;
+        check(false == corruptedModel.loadModel(corruptedPath), corruptedCase.description + " is rejected");
+    }
+
+    std::remove(modelPath.c_str());
+    std::remove(corruptedPath.c_str());
+
+    return testResult();
+}
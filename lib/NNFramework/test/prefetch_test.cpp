@@ -0,0 +1,152 @@
+#include <iostream>
+#include <string>
+#include <memory>
+#include <vector>
+#include "NNFramework/NNFramework"
+#include "Test.hpp"
+
+using namespace NNFramework;
+
+constexpr uint8_t INPUTS_NO = 5U;
+constexpr uint8_t OUTPUTS_NO = 2U;
+constexpr uint16_t EPOCHS_NO = 3U;
+constexpr uint64_t SEED = 2024U;
+
+// data rows requested by each nextBatch(), the last batch of an epoch is shorter
+constexpr Eigen::Index BATCH_COLS = 16;
+
+// Batches taken from a data source, data rows as columns
+struct Batches final
+{
+    std::vector<Matrix> inBatches;
+    std::vector<Matrix> expBatches;
+
+    bool operator==(const Batches& other) const
+    {
+        return (inBatches == other.inBatches) && (expBatches == other.expBatches);
+    }
+};
+
+// Take up to batchesNo batches of the current epoch, batchesNo = 0 -> until the end of the epoch
+Batches takeBatches(DataSource::DataSource& source, const size_t batchesNo = 0U)
+{
+    Batches batches;
+    Matrix inBatch(source.inputColsNo(), BATCH_COLS);
+    Matrix expBatch(source.expectedColsNo(), BATCH_COLS);
+
+    while((0U == batchesNo) || (batches.inBatches.size() < batchesNo))
+    {
+        const uint32_t rows = source.nextBatch(inBatch, expBatch);
+        if(0U == rows)
+        {
+            break;
+        }
+
+        batches.inBatches.push_back(inBatch.leftCols(rows));
+        batches.expBatches.push_back(expBatch.leftCols(rows));
+    }
+
+    return batches;
+}
+
+// Shuffled epochs of the data source, an epoch is cancelled after cancelAfter batches (0 -> no epoch is cancelled)
+std::vector<Batches> takeEpochs(DataSource::DataSource& source, const size_t cancelAfter = 0U)
+{
+    std::vector<Batches> epochs;
+
+    for(uint16_t epoch = 0; epoch < EPOCHS_NO; ++epoch)
+    {
+        source.reset(true);
+
+        // reset() in the middle of the epoch starts the epoch over
+        if((0U != cancelAfter) && (1U == epoch))
+        {
+            epochs.push_back(takeBatches(source, cancelAfter));
+            source.reset(true);
+        }
+
+        epochs.push_back(takeBatches(source));
+    }
+
+    return epochs;
+}
+
+// Parameters of the model trained on the data with the same seed
+Vector trainedParameters(const FitCase& fitCase, const Matrix& inData, const Matrix& expData)
+{
+    Random::setGlobalSeed(SEED);
+
+    std::shared_ptr<Model::Model> model = buildModel(fitCase, { INPUTS_NO, 8U, OUTPUTS_NO }, 8U);
+    DataSource::MatrixDataSource dataSource(inData, expData);
+    model->modelFit(dataSource, EPOCHS_NO);
+
+    return model->get_mParameters();
+}
+
+int main()
+{
+    const Matrix inData = Matrix::Random(100, INPUTS_NO);
+    const Matrix expData = Matrix::Random(100, OUTPUTS_NO).cwiseAbs();
+
+    // reference batches of the wrapped data source
+    Random::setGlobalSeed(SEED);
+    DataSource::MatrixDataSource directSource(inData, expData);
+    const std::vector<Batches> directEpochs = takeEpochs(directSource);
+
+    Random::setGlobalSeed(SEED);
+    DataSource::MatrixDataSource directCancelSource(inData, expData);
+    const std::vector<Batches> directCancelEpochs = takeEpochs(directCancelSource, 2U);
+
+    // batches of each epoch are shuffled, thus batches taken in a different order do not compare equal
+    check(false == (directEpochs[0] == directEpochs[1]), "shuffled epochs of the wrapped data source differ");
+
+    for(const uint32_t prefetchDepth : { 1U, 2U, 8U })
+    {
+        const std::string depth = "prefetch depth " + std::to_string(prefetchDepth);
+
+        // prefetched batches are the batches of the wrapped data source in the same order
+        {
+            Random::setGlobalSeed(SEED);
+            DataSource::MatrixDataSource source(inData, expData);
+            DataSource::PrefetchDataSource prefetchSource(source, prefetchDepth);
+
+            check(directEpochs == takeEpochs(prefetchSource), depth + ", prefetched shuffled epochs equal the epochs of the wrapped data source");
+        }
+
+        // reset() in the middle of an epoch drops the prefetched batches, the next epoch starts from its first batch
+        {
+            Random::setGlobalSeed(SEED);
+            DataSource::MatrixDataSource source(inData, expData);
+            DataSource::PrefetchDataSource prefetchSource(source, prefetchDepth);
+
+            check(directCancelEpochs == takeEpochs(prefetchSource, 2U), depth + ", epoch cancelled after 2 batches is started over");
+        }
+
+        // producer in the middle of an epoch is stopped by the destructor
+        {
+            DataSource::MatrixDataSource source(inData, expData);
+            DataSource::PrefetchDataSource prefetchSource(source, prefetchDepth);
+
+            prefetchSource.reset(true);
+            check(1U == takeBatches(prefetchSource, 1U).inBatches.size(), depth + ", prefetching data source is destroyed in the middle of an epoch");
+        }
+    }
+
+    // training with prefetch takes the same batches as without it, thus the trained parameters are equal
+    const std::vector<FitCase> fitCases = {
+        { "1 thread", 1U, false, 0U, nullptr },
+        { "2 threads", 2U, false, 0U, nullptr } };
+
+    for(const FitCase& fitCase : fitCases)
+    {
+        const Vector expected = trainedParameters(fitCase, inData, expData);
+
+        for(const uint32_t prefetchDepth : { 1U, 4U })
+        {
+            const Vector prefetched = trainedParameters({ fitCase.description, fitCase.threadsNo, fitCase.hogwild, prefetchDepth, nullptr }, inData, expData);
+            check(expected == prefetched, fitCase.description + ", training with prefetch depth " + std::to_string(prefetchDepth) + " equals training without prefetch");
+        }
+    }
+
+    return testResult();
+}
@@ -0,0 +1,267 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <numeric>
+#include "NNFramework/NNFramework"
+#include "Benchmark.hpp"
+
+using namespace NNFramework;
+
+// Build and compile Dense model with depth hidden layers of width perceptrons
+std::shared_ptr<Model::Model> buildModel(const uint8_t inputsNo, const uint8_t width, const uint32_t depth, const uint8_t outputsNo, 
+                                         const uint32_t batchSize, const uint16_t threadsNo)
+{
+    std::shared_ptr<Model::Model> model = std::make_shared<Model::Model>();
+
+    Model::ModelConfiguration::ModelConfiguration modelConfig { Loss::LossType<Loss::MeanSquaredError>(), 
+                                                                Metrics::MetricsType<Metrics::MeanSquaredError>(), 
+                                                                Optimizers::OptimizersType<Optimizers::GradientDescent>(),
+                                                                Model::ModelConfiguration::ShuffleData { false, 1 } };
+    modelConfig.mBatchSize = batchSize;
+    modelConfig.mThreadsNo = threadsNo;
+
+    model->addLayer(Layers::Dense(inputsNo));
+    for (uint32_t i = 0; i < depth; ++i)
+    {
+        model->addLayer(Layers::Dense(width, Activations::ActivationType<Activations::LeakyRelu>()));
+    }
+    model->addLayer(Layers::Dense(outputsNo, Activations::ActivationType<Activations::Sigmoid>()));
+
+    model->compileModel(modelConfig);
+
+    return model;
+}
+
+// Print usage of the benchmark executable
+void printUsage()
+{
+    std::cout << "Usage: NNFramework_bench [--out <file>] [--format csv|json] [--baseline <csv file>] [--tolerance <fraction>] [--quick]" << std::endl;
+    std::cout << "  --out        write results to the file (default: stdout only)" << std::endl;
+    std::cout << "  --format     results file format (default: csv)" << std::endl;
+    std::cout << "  --baseline   compare results to a CSV file written by a previous run, exit code 1 on regression" << std::endl;
+    std::cout << "  --tolerance  allowed slowdown against the baseline (default: 0.10)" << std::endl;
+    std::cout << "  --quick      reduced parameter grid and measurement time" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    std::string outPath;
+    std::string format = "csv";
+    std::string baselinePath;
+    double tolerance = 0.10;
+    bool quick = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+
+        if(("--out" == arg) && ((i + 1) < argc)) { outPath = argv[++i]; }
+        else if(("--format" == arg) && ((i + 1) < argc)) { format = argv[++i]; }
+        else if(("--baseline" == arg) && ((i + 1) < argc)) { baselinePath = argv[++i]; }
+        else if(("--tolerance" == arg) && ((i + 1) < argc)) { tolerance = std::stod(argv[++i]); }
+        else if("--quick" == arg) { quick = true; }
+        else { printUsage(); return 2; }
+    }
+
+    const double minTimeSec = quick ? 0.02 : 0.2;
+
+    // parameter grid
+    const std::vector<uint32_t> widths = quick ? std::vector<uint32_t>{ 16, 128 } : std::vector<uint32_t>{ 16, 64, 128, 255 };
+    const std::vector<uint32_t> depths = quick ? std::vector<uint32_t>{ 1 } : std::vector<uint32_t>{ 1, 3 };
+    const std::vector<uint32_t> batchSizes = quick ? std::vector<uint32_t>{ 1, 64 } : std::vector<uint32_t>{ 1, 16, 64, 256 };
+    const std::vector<uint16_t> threadCounts = quick ? std::vector<uint16_t>{ 1, 2 } : std::vector<uint16_t>{ 1, 2, 4 };
+    const std::vector<uint32_t> elementCounts = quick ? std::vector<uint32_t>{ 1U << 12 } : std::vector<uint32_t>{ 1U << 10, 1U << 14, 1U << 18 };
+    const std::vector<uint32_t> dataRows = quick ? std::vector<uint32_t>{ 4096 } : std::vector<uint32_t>{ 1024, 16384, 131072 };
+
+    std::vector<BenchmarkResult> results;
+
+    // Activation functors, activation and derivative
+    std::vector<std::unique_ptr<Activations::ActivationFunctor>> activations;
+    activations.push_back(std::make_unique<Activations::Sigmoid>());
+    activations.push_back(std::make_unique<Activations::Sigmoid>(Activations::FAST));
+    activations.push_back(std::make_unique<Activations::Tanh>());
+    activations.push_back(std::make_unique<Activations::Tanh>(Activations::FAST));
+    activations.push_back(std::make_unique<Activations::Softplus>());
+    activations.push_back(std::make_unique<Activations::Softplus>(Activations::FAST));
+    activations.push_back(std::make_unique<Activations::Relu>());
+    activations.push_back(std::make_unique<Activations::LeakyRelu>());
+    activations.push_back(std::make_unique<Activations::Elu>());
+    activations.push_back(std::make_unique<Activations::HardSigmoid>());
+
+    for (const uint32_t elements : elementCounts)
+    {
+        Matrix x = Matrix::Random(64, elements / 64);
+        Matrix y(x.rows(), x.cols());
+        const std::string params = "elements=" + std::to_string(elements);
+
+        for (const auto& activation : activations)
+        {
+            results.push_back(runBenchmark(activation->name() + "::activate", params, [&]() { activation->activate(x, y); doNotOptimize(y.data()[0]); }, elements, minTimeSec));
+            results.push_back(runBenchmark(activation->name() + "::derivative", params, [&]() { activation->derivative(x, y); doNotOptimize(y.data()[0]); }, elements, minTimeSec));
+        }
+    }
+
+    // Loss functors, loss and derivative
+    std::vector<std::unique_ptr<Loss::LossFunctor>> losses;
+    losses.push_back(std::make_unique<Loss::MeanSquaredError>());
+    losses.push_back(std::make_unique<Loss::MeanAbsoluteError>());
+    losses.push_back(std::make_unique<Loss::BinaryCrossEntropy>());
+
+    for (const uint32_t elements : elementCounts)
+    {
+        // keep values in (0, 1) for cross entropy
+        Matrix expected = (Matrix::Random(64, elements / 64).array() * 0.4 + 0.5).matrix();
+        Matrix predicted = (Matrix::Random(64, elements / 64).array() * 0.4 + 0.5).matrix();
+        Matrix result(expected.rows(), expected.cols());
+        const std::string params = "elements=" + std::to_string(elements);
+
+        for (const auto& loss : losses)
+        {
+            results.push_back(runBenchmark(loss->name() + "::loss", params, [&]() { loss->loss(expected, predicted, result); doNotOptimize(result.data()[0]); }, elements, minTimeSec));
+            results.push_back(runBenchmark(loss->name() + "::derivative", params, [&]() { loss->derivative(expected, predicted, result); doNotOptimize(result.data()[0]); }, elements, minTimeSec));
+        }
+    }
+
+    // Optimizer step
+    for (const uint32_t elements : elementCounts)
+    {
+        Optimizers::GradientDescent optimizer;
+        optimizer.learningRate = 1e-9;
+        Vector parameters = Vector::Random(elements);
+        Vector gradients = Vector::Random(elements);
+
+        results.push_back(runBenchmark("GradientDescent", "elements=" + std::to_string(elements), 
+                                       [&]() { optimizer(parameters, gradients); doNotOptimize(parameters.data()[0]); }, elements, minTimeSec));
+    }
+
+    // Random bulk generation (weights initialization)
+    for (const uint32_t elements : elementCounts)
+    {
+        Matrix values(64, elements / 64);
+        const std::string params = "elements=" + std::to_string(elements);
+
+        results.push_back(runBenchmark("Random::fillUniform", params, [&]() { Random::fillUniform(values, -1.0, 1.0, elements); doNotOptimize(values.data()[0]); }, elements, minTimeSec));
+        results.push_back(runBenchmark("Random::fillNormal", params, [&]() { Random::fillNormal(values, 0.0, 1.0, elements); doNotOptimize(values.data()[0]); }, elements, minTimeSec));
+    }
+
+    // DataHandler
+    std::unique_ptr<DataHandler::DataHandler>& dHandleRef = DataHandler::DataHandler::getInstance();
+
+    for (const uint32_t rows : dataRows)
+    {
+        Matrix inData = Matrix::Random(rows, 8);
+        Matrix expData = Matrix::Random(rows, 1);
+        const std::string params = "rows=" + std::to_string(rows) + ";cols=8";
+
+        results.push_back(runBenchmark("DataHandler::shuffleData", params, [&]() { dHandleRef->shuffleData(inData, expData); doNotOptimize(inData.data()[0]); }, rows, minTimeSec));
+
+        std::vector<Eigen::Index> indices(rows);
+        std::iota(indices.begin(), indices.end(), 0);
+        Random::Xoshiro256 engine(rows);
+        results.push_back(runBenchmark("DataHandler::shuffleIndices", params, [&]() { dHandleRef->shuffleIndices(indices, engine); doNotOptimize(indices[0]); }, rows, minTimeSec));
+
+        Matrix original = inData;
+        Scaler::Scaler normalizeScaler;
+        results.push_back(runBenchmark("DataHandler::normalizeData", params, [&]() { inData = original; dHandleRef->normalizeData(inData, normalizeScaler); doNotOptimize(inData.data()[0]); }, rows, minTimeSec));
+
+        Scaler::Scaler scaler(Scaler::Scaler::STANDARD);
+        results.push_back(runBenchmark("Scaler::fit", params, [&]() { scaler.fit(original); doNotOptimize(scaler.get_mMean().data()[0]); }, rows, minTimeSec));
+        results.push_back(runBenchmark("Scaler::transform", params, [&]() { inData = original; scaler.transform(inData); doNotOptimize(inData.data()[0]); }, rows, minTimeSec));
+    }
+
+    // DataHandler::loadData, data file is generated from the random data
+    for (const uint32_t rows : dataRows)
+    {
+        const std::string path = "./nnframework_bench_data.txt";
+        {
+            Matrix data = Matrix::Random(rows, 2);
+            std::ofstream out(path);
+            out.precision(18);
+            for (uint32_t i = 0; i < rows; ++i)
+            {
+                out << data(i, 0) << " " << data(i, 1) << std::endl;
+            }
+        }
+
+        results.push_back(runBenchmark("DataHandler::loadData", "rows=" + std::to_string(rows) + ";cols=2", 
+                                       [&]() { auto data = dHandleRef->loadData(path, 1, 1); doNotOptimize(std::get<0>(data).data()[0]); }, rows, minTimeSec));
+
+        std::remove(path.c_str());
+    }
+
+    // Forward pass (modelPredict) trough preallocated InferenceContext
+    for (const uint32_t width : widths)
+    {
+        for (const uint32_t depth : depths)
+        {
+            std::shared_ptr<const Model::Model> model = buildModel(8, width, depth, 1, 1, 1);
+            Model::InferenceContext::InferenceContext context(model);
+
+            for (const uint32_t batchSize : batchSizes)
+            {
+                Matrix inData = Matrix::Random(batchSize, 8);
+                Matrix predicted(batchSize, 1);
+                const std::string params = "width=" + std::to_string(width) + ";depth=" + std::to_string(depth) + ";batch=" + std::to_string(batchSize);
+
+                results.push_back(runBenchmark("modelPredict", params, [&]() { context.predictInto(inData, predicted); doNotOptimize(predicted.data()[0]); }, batchSize, minTimeSec));
+            }
+        }
+    }
+
+    // Training epoch (forwardPass, backPropagation and optimizer step for each batch)
+    for (const uint32_t width : widths)
+    {
+        for (const uint32_t depth : depths)
+        {
+            for (const uint32_t batchSize : batchSizes)
+            {
+                for (const uint16_t threadsNo : threadCounts)
+                {
+                    // multi-threaded training of single row batches is not meaningful
+                    if((threadsNo > 1U) && (batchSize < threadsNo))
+                    {
+                        continue;
+                    }
+
+                    const uint32_t rows = 1024U;
+                    std::shared_ptr<Model::Model> model = buildModel(8, width, depth, 1, batchSize, threadsNo);
+                    Matrix inData = Matrix::Random(rows, 8);
+                    Matrix expData = (Matrix::Random(rows, 1).array() * 0.5 + 0.5).matrix();
+                    const std::string params = "width=" + std::to_string(width) + ";depth=" + std::to_string(depth) + ";batch=" + std::to_string(batchSize) + 
+                                               ";threads=" + std::to_string(threadsNo);
+
+                    results.push_back(runBenchmark("modelFit", params, [&]() { model->modelFit(inData, expData, 1); }, rows, minTimeSec, 3U));
+                }
+            }
+        }
+    }
+
+    // write results
+    if(false == outPath.empty())
+    {
+        std::ofstream out(outPath);
+
+        if("json" == format)
+        {
+            writeJson(out, results);
+        }
+        else
+        {
+            writeCsv(out, results);
+        }
+    }
+
+    // compare results to the baseline
+    if(false == baselinePath.empty())
+    {
+        const uint32_t regressionsNo = compareToBaseline(results, readCsvBaseline(baselinePath), tolerance);
+
+        std::cout << regressionsNo << " regression(s) against baseline " << baselinePath << std::endl;
+
+        return (NNFRAMEWORK_ZERO == regressionsNo) ? 0 : 1;
+    }
+
+    return 0;
+}
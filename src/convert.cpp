@@ -0,0 +1,97 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sstream>
+#include "NNFramework/NNFramework"
+
+using namespace NNFramework;
+
+// Print usage of the dataset conversion executable
+void printUsage()
+{
+    std::cout << "Usage: NNFramework_convert <text data file> <dataset path> [--columns <name:role,...>] [--shard-rows <rows>] [--dtype float32|float64]" << std::endl;
+    std::cout << "  --columns     name and role (input or label) of each column of the text data file" << std::endl;
+    std::cout << "                (default: c0, c1, ... where the last column is label and the rest are input)" << std::endl;
+    std::cout << "  --shard-rows  number of data rows in each shard file (default: single shard)" << std::endl;
+    std::cout << "  --dtype       type of the stored values (default: float64)" << std::endl;
+    std::cout << "Shards are written to <dataset path>.0, <dataset path>.1, ..." << std::endl;
+}
+
+// Parse --columns argument "name:role,name:role,..."
+bool parseColumns(const std::string& arg, std::vector<std::string>& names, std::vector<Dataset::DatasetFile::ColumnRole>& roles)
+{
+    std::stringstream s(arg);
+    std::string column;
+
+    while(getline(s, column, ','))
+    {
+        const size_t separator = column.rfind(':');
+        const std::string role = (std::string::npos == separator) ? "" : column.substr(separator + 1U);
+
+        if("input" == role) { roles.push_back(Dataset::DatasetFile::INPUT_COLUMN); }
+        else if("label" == role) { roles.push_back(Dataset::DatasetFile::LABEL_COLUMN); }
+        else { return false; }
+
+        names.push_back(column.substr(0U, separator));
+    }
+
+    return (false == names.empty());
+}
+
+int main(int argc, char** argv)
+{
+    if(argc < 3)
+    {
+        printUsage();
+        return 2;
+    }
+
+    const std::string dataPath = argv[1];
+    const std::string datasetPath = argv[2];
+    std::vector<std::string> columnNames;
+    std::vector<Dataset::DatasetFile::ColumnRole> columnRoles;
+    uint64_t shardRows = 0U;
+    Dataset::DatasetFile::DataType dataType = Dataset::DatasetFile::FLOAT64;
+
+    for (int i = 3; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+
+        if(("--columns" == arg) && ((i + 1) < argc) && (true == parseColumns(argv[++i], columnNames, columnRoles))) { }
+        else if(("--shard-rows" == arg) && ((i + 1) < argc)) { shardRows = std::stoull(argv[++i]); }
+        else if(("--dtype" == arg) && ((i + 1) < argc) && ("float32" == std::string(argv[i + 1]))) { dataType = Dataset::DatasetFile::FLOAT32; ++i; }
+        else if(("--dtype" == arg) && ((i + 1) < argc) && ("float64" == std::string(argv[i + 1]))) { dataType = Dataset::DatasetFile::FLOAT64; ++i; }
+        else { printUsage(); return 2; }
+    }
+
+    // text data file is parsed only once, every later run maps the dataset shards
+    std::unique_ptr<DataHandler::DataHandler>& dHandleRef = DataHandler::DataHandler::getInstance();
+    Matrix data = dHandleRef->loadData(dataPath);
+
+    // default column names and roles
+    if(true == columnNames.empty())
+    {
+        for (Eigen::Index i = 0; i < data.cols(); ++i)
+        {
+            columnNames.push_back("c" + std::to_string(i));
+            columnRoles.push_back(((i + 1) == data.cols()) ? Dataset::DatasetFile::LABEL_COLUMN : Dataset::DatasetFile::INPUT_COLUMN);
+        }
+    }
+
+    if(false == Dataset::Dataset::saveDataset(datasetPath, data, columnNames, columnRoles, shardRows, dataType))
+    {
+        return 1;
+    }
+
+    // summary of the written dataset
+    Dataset::Dataset dataset(datasetPath);
+    std::cout << "Dataset " << datasetPath << ": " << dataset.get_mRowsNo() << " rows, " << dataset.get_mShardsNo() << " shard(s)" << std::endl;
+    for (uint32_t i = 0; i < dataset.get_mColumnsNo(); ++i)
+    {
+        const Dataset::ColumnStats& stats = dataset.get_mColumnStats(i);
+        std::cout << "  " << dataset.get_mColumnName(i) << " (" << ((Dataset::DatasetFile::INPUT_COLUMN == dataset.get_mColumnRole(i)) ? "input" : "label") << ")"
+                  << " min: " << stats.min << " max: " << stats.max << " mean: " << stats.mean << " std: " << stats.stdDev << std::endl;
+    }
+
+    return 0;
+}
@@ -21,6 +21,9 @@ int main()
     modelConfig.mOptimizerPtr->learningRate = 0.1;
     modelConfig.mShuffleData->mShuffleStep = 10;
 
+    // log training progress at most twice per second
+    modelConfig.mCallbacks.push_back(std::make_shared<Callbacks::ProgressLogger>(std::chrono::milliseconds(500)));
+
     // Add layers to NN model
     model.addLayer(Layers::Dense(1)); // or -> model.addLayer(Layers::Dense(3, Activations::ActivationType<Activations::InputActivation>()));
     model.addLayer(Layers::Dense(20, Activations::ActivationType<Activations::LeakyRelu>()));
@@ -32,17 +35,25 @@ int main()
     // Log model summary
     model.modelSummary();
 
-    // read input data and labels from input file
-    std::tuple loadedData = loadData("./data/input_data.txt", 200, 1, 1);
-    Eigen::MatrixXd inData = std::get<0>(loadedData);
-    Eigen::MatrixXd labelsData = std::get<1>(loadedData);
-
     // retireve instance of DataHandler class
     std::unique_ptr<NNFramework::DataHandler::DataHandler>& dHandleRef = NNFramework::DataHandler::DataHandler::getInstance();
 
-    // Normalize input and expected data
-    Eigen::MatrixXd inDataNormalized = dHandleRef->normalizeData(inData); 
-    Eigen::MatrixXd outDataNormalized = dHandleRef->normalizeData(labelsData);
+    // read input data and labels from input file, number of data rows is inferred from the file
+    std::tuple loadedData = dHandleRef->loadData("./data/input_data.txt", 1, 1);
+    Matrix inData = std::get<0>(loadedData);
+    Matrix labelsData = std::get<1>(loadedData);
+
+    // Normalize input and expected data in range [0, 1]
+    // scalers keep the min and max of each column, original data is kept for plotting
+    NNFramework::Scaler::Scaler inScaler(NNFramework::Scaler::Scaler::MIN_MAX);
+    NNFramework::Scaler::Scaler outScaler(NNFramework::Scaler::Scaler::MIN_MAX);
+    inScaler.fit(inData);
+    outScaler.fit(labelsData);
+
+    Matrix inDataNormalized = inData;
+    Matrix outDataNormalized = labelsData;
+    inScaler.transform(inDataNormalized);
+    outScaler.transform(outDataNormalized);
 
     // train model on normalized data for 50 epochs
     model.modelFit(inDataNormalized, outDataNormalized, 50);
@@ -52,10 +63,10 @@ int main()
     //std::cout << "Model history: " << std::endl << "Loss: " << modelHistory.hLoss << std::endl << "Accuracy: " << modelHistory.hAccuracy << std::endl;
 
     // Predict on trained model
-    Eigen::MatrixXd predictedData = model.modelPredict(inDataNormalized);
+    Matrix predictedData = model.modelPredict(inDataNormalized);
 
     // denormalize predicted data
-    predictedData = dHandleRef->denormalizeData(predictedData, labelsData.minCoeff(), labelsData.maxCoeff());
+    outScaler.inverseTransform(predictedData);
 
     //sort data based on xi values for the purposes of graph plotting 
     std::tuple sortedPredData = sortData(inData, predictedData);